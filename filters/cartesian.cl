@@ -1,72 +1,182 @@
-kernel void toSpherical(
-    uint inDepth, uint inLength, uint inWidth, global uint *input,
-    uint outDepth, uint outLength, uint outWidth, global uint *output,
-    float ratio, float angleDelta) // ratio is the ratio of empty space to depth
-{
-    uint x = get_global_id(0); // Depth
-    uint y = get_global_id(1); // Length
-    uint z = get_global_id(2); // Width
-
-
-    float r = convert_float(inDepth) * ratio;
-
-    float halfAngle = angleDelta / 2.0f;
-    float voff =  r + convert_float(inDepth) - convert_float(outDepth);
-
-    if (x == 0 && y == 0 && z == 0)
-    {
-        printf("%f\n", voff);
-    }
-
-    float3 centrepoint = (float3)(0.0f, convert_float(outLength) / 2, convert_float(outWidth) / 2);
-    float3 pos = (float3)(convert_float(x)+voff, convert_float(y), convert_float(z));
-    pos = pos - centrepoint;
-
-    float lAngle = atan2(pos.y, pos.x);
-    float wAngle = atan2(pos.z, pos.x);
-
-    float R = length(pos);
-
-    if (R < r || R > r + inDepth - 1 || fabs(lAngle) > halfAngle || fabs(wAngle) > halfAngle)
-    {
-        output[x + y * outDepth + z * outDepth * outLength] = 0; // Inside empty space
-        return;
-    }
-
-    uint x_in = clamp(R - r, 0.0f, inDepth - 1.0f);
-    uint y_in = clamp((lAngle / halfAngle / 2.0f + 0.5f) * (inLength - 1.0f), 0.0f, inLength - 1.0f);
-    uint z_in = clamp((wAngle / halfAngle / 2.0f + 0.5f) * (inWidth - 1.0f), 0.0f, inWidth - 1.0f);
-
-    output[x + y * outDepth + z * outDepth * outLength] = input[x_in + y_in * inDepth + z_in * inDepth * inLength];
-}
-
-kernel void toCartesian(
-    uint inDepth, uint inLength, uint inWidth, global uint *input,
-    uint outDepth, uint outLength, uint outWidth, global uint *output,
-    float ratio, float angleDelta)
-{
-    uint x = get_global_id(0); // Depth
-    uint y = get_global_id(1); // Length
-    uint z = get_global_id(2); // Width
-
-    float3 centrepoint = (float3)(0.0f, convert_float(outLength) / 2, convert_float(outWidth) / 2);
-    float3 pos = (float3)(convert_float(x), convert_float(y), convert_float(z));
-    pos = pos - centrepoint;
-
-    float angleY = pos.y / convert_float(outLength / 2) * angleDelta / 2.0f;
-    float angleZ = pos.z / convert_float(outLength / 2) * angleDelta / 2.0f;
-
-    float r = convert_float(inDepth) * (ratio / (1.0f + ratio));
-
-    pos.x *= convert_float(inDepth - r) / convert_float(outDepth);
-    pos.y *= convert_float(inLength) / convert_float(outLength);
-    pos.z *= convert_float(inWidth) / convert_float(outWidth);
-
-    float d = r + length(pos);
-
-    uint x_in = clamp(d * cos(angleY), 0.0f, inDepth - 1.0f);
-    uint y_in = clamp(d * sin(angleY), 0.0f, inLength - 1.0f);
-    uint z_in = clamp(d * sin(angleZ), 0.0f, inWidth - 1.0f);
-
-    output[x + y * outDepth + z * outDepth * outLength] = input[x_in + y_in * inDepth + z_in * inDepth * inLength];
+// Scan conversion goes through a lookup table built once per geometry: for every output voxel the index of
+// the lower corner of its source cell and the trilinear fractions (w = 0 marks voxels outside the fan).
+// Per frame conversion is then a gather.
+
+inline void tableEntry(
+    float3 p, bool inside, uint inDepth, uint inLength, uint inWidth,
+    global uint *index, global uchar4 *weight, uint i)
+{
+    float3 hi = (float3)(convert_float(inDepth) - 1.0f, convert_float(inLength) - 1.0f, convert_float(inWidth) - 1.0f);
+    p = clamp(p, (float3)(0.0f), hi);
+
+    // The corner stays one short of the far edge so corner + 1 is inside, the fraction then reaches 1.
+    float3 corner = min(floor(p), max(hi - 1.0f, (float3)(0.0f)));
+    uint3 c = convert_uint3(corner);
+    float3 f = p - corner;
+
+    index[i] = c.x + c.y * inDepth + c.z * inDepth * inLength;
+    weight[i] = inside ? (uchar4)(convert_uchar3_sat_rte(f * 255.0f), 0xFF) : (uchar4)(0);
+}
+
+kernel void sphericalTable(
+    uint inDepth, uint inLength, uint inWidth,
+    uint outDepth, uint outLength, uint outWidth,
+    float ratio, float angleDelta, // ratio is the ratio of empty space to depth
+    global uint *index, global uchar4 *weight)
+{
+    uint x = get_global_id(0); // Depth
+    uint y = get_global_id(1); // Length
+    uint z = get_global_id(2); // Width
+
+    float r = convert_float(inDepth) * ratio;
+
+    float halfAngle = angleDelta / 2.0f;
+    float voff = r + convert_float(inDepth) - convert_float(outDepth);
+
+    float3 centrepoint = (float3)(0.0f, convert_float(outLength) / 2, convert_float(outWidth) / 2);
+    float3 pos = (float3)(convert_float(x) + voff, convert_float(y), convert_float(z));
+    pos = pos - centrepoint;
+
+    float lAngle = atan2(pos.y, pos.x);
+    float wAngle = atan2(pos.z, pos.x);
+
+    float R = length(pos);
+
+    bool inside = !(R < r || R > r + inDepth - 1 || fabs(lAngle) > halfAngle || fabs(wAngle) > halfAngle);
+
+    float3 p = (float3)(
+        R - r,
+        (lAngle / halfAngle / 2.0f + 0.5f) * (inLength - 1.0f),
+        (wAngle / halfAngle / 2.0f + 0.5f) * (inWidth - 1.0f));
+
+    tableEntry(p, inside, inDepth, inLength, inWidth, index, weight, x + y * outDepth + z * outDepth * outLength);
+}
+
+kernel void cartesianTable(
+    uint inDepth, uint inLength, uint inWidth,
+    uint outDepth, uint outLength, uint outWidth,
+    float ratio, float angleDelta,
+    global uint *index, global uchar4 *weight)
+{
+    uint x = get_global_id(0); // Depth
+    uint y = get_global_id(1); // Length
+    uint z = get_global_id(2); // Width
+
+    float3 centrepoint = (float3)(0.0f, convert_float(outLength) / 2, convert_float(outWidth) / 2);
+    float3 pos = (float3)(convert_float(x), convert_float(y), convert_float(z));
+    pos = pos - centrepoint;
+
+    float angleY = pos.y / convert_float(outLength / 2) * angleDelta / 2.0f;
+    float angleZ = pos.z / convert_float(outLength / 2) * angleDelta / 2.0f;
+
+    float r = convert_float(inDepth) * (ratio / (1.0f + ratio));
+
+    pos.x *= convert_float(inDepth - r) / convert_float(outDepth);
+    pos.y *= convert_float(inLength) / convert_float(outLength);
+    pos.z *= convert_float(inWidth) / convert_float(outWidth);
+
+    float d = r + length(pos);
+
+    float3 p = (float3)(d * cos(angleY), d * sin(angleY), d * sin(angleZ));
+
+    tableEntry(p, true, inDepth, inLength, inWidth, index, weight, x + y * outDepth + z * outDepth * outLength);
+}
+
+// Physical grid over the fan's bounding box: grid.xyz is the position of voxel 0 relative to the apex and grid.w
+// the (isotropic) spacing, in the units of range, the beam distance of the first and last sample. Lines run
+// from angle lines.x to lines.y, not necessarily about the axis, and width beams over angleDelta about it.
+kernel void fanTable(
+    uint inDepth, uint inLength, uint inWidth,
+    uint outDepth, uint outLength, uint outWidth,
+    float ratio, float angleDelta,
+    global uint *index, global uchar4 *weight,
+    float4 grid, float2 range, float2 lines)
+{
+    uint x = get_global_id(0); // Depth
+    uint y = get_global_id(1); // Length
+    uint z = get_global_id(2); // Width
+
+    float3 pos = grid.xyz + (float3)(convert_float(x), convert_float(y), convert_float(z)) * grid.w;
+
+    float halfAngle = angleDelta / 2.0f;
+    float lAngle = atan2(pos.y, pos.x);
+    float wAngle = inWidth > 1 ? atan2(pos.z, pos.x) : 0.0f;
+    float R = length(pos);
+
+    bool inside = R >= range.x && R <= range.y && lAngle >= lines.x && lAngle <= lines.y && fabs(wAngle) <= halfAngle;
+
+    float3 p = (float3)(
+        (R - range.x) / (range.y - range.x) * (inDepth - 1.0f),
+        (lAngle - lines.x) / (lines.y - lines.x) * (inLength - 1.0f),
+        (wAngle / halfAngle / 2.0f + 0.5f) * (inWidth - 1.0f));
+
+    tableEntry(p, inside, inDepth, inLength, inWidth, index, weight, x + y * outDepth + z * outDepth * outLength);
+}
+
+kernel void scanConvert(
+    uint inDepth, uint inLength, uint inWidth, global uchar4 *input,
+    uint outDepth, uint outLength, uint outWidth, global uchar4 *output,
+    global uint *index, global uchar4 *weight)
+{
+    uint x = get_global_id(0); // Depth
+    uint y = get_global_id(1); // Length
+    uint z = get_global_id(2) % outWidth; // Width, frames of a batch are stacked along z
+
+    uint frame = get_global_id(2) / outWidth;
+    input += frame * inDepth * inLength * inWidth;
+    output += frame * outDepth * outLength * outWidth;
+
+    uint i = x + y * outDepth + z * outDepth * outLength;
+    uchar4 w = weight[i];
+    if (w.w == 0)
+    {
+        output[i] = (uchar4)(0); // Inside empty space
+        return;
+    }
+
+    // Flat axes (2D volumes) have no neighbour to blend with
+    uint sx = inDepth > 1 ? 1 : 0;
+    uint sy = inLength > 1 ? inDepth : 0;
+    uint sz = inWidth > 1 ? inDepth * inLength : 0;
+
+    float3 f = convert_float3(w.xyz) / 255.0f;
+    global uchar4 *c = input + index[i];
+
+    float4 c00 = mix(convert_float4(c[0]), convert_float4(c[sx]), f.x);
+    float4 c10 = mix(convert_float4(c[sy]), convert_float4(c[sy + sx]), f.x);
+    float4 c01 = mix(convert_float4(c[sz]), convert_float4(c[sz + sx]), f.x);
+    float4 c11 = mix(convert_float4(c[sz + sy]), convert_float4(c[sz + sy + sx]), f.x);
+
+    output[i] = convert_uchar4_sat_rte(mix(mix(c00, c10, f.y), mix(c01, c11, f.y), f.z));
+}
+
+// scanConvert with the input as an image, the hardware blends the eight neighbours in one filtered fetch. Frames
+// of a batch are stacked along the image's z.
+constant sampler_t linearSampler = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_LINEAR;
+
+kernel void scanConvertImage(
+    uint inDepth, uint inLength, uint inWidth, read_only image3d_t input,
+    uint outDepth, uint outLength, uint outWidth, global uchar4 *output,
+    global uint *index, global uchar4 *weight)
+{
+    uint x = get_global_id(0); // Depth
+    uint y = get_global_id(1); // Length
+    uint z = get_global_id(2) % outWidth; // Width
+
+    uint frame = get_global_id(2) / outWidth;
+    output += frame * outDepth * outLength * outWidth;
+
+    uint i = x + y * outDepth + z * outDepth * outLength;
+    uchar4 w = weight[i];
+    if (w.w == 0)
+    {
+        output[i] = (uchar4)(0); // Inside empty space
+        return;
+    }
+
+    uint c = index[i];
+    float3 corner = (float3)(convert_float(c % inDepth), convert_float(c / inDepth % inLength), convert_float(c / (inDepth * inLength) + frame * inWidth));
+    float3 p = corner + convert_float3(w.xyz) / 255.0f + 0.5f;
+
+    output[i] = convert_uchar4_sat_rte(read_imagef(input, linearSampler, (float4)(p, 0.0f)) * 255.0f);
 }
\ No newline at end of file
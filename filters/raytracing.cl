@@ -1,121 +1,344 @@
-// #define stepLim 500
-// #define td 0.01f
-
-int rayHitBBox(float4 rayOrg, float4 rayDir, float4 bbMin, float4 bbMax, float *nPlane, float *fPlane)
-{
-    // Ray intersections with BBox.
-    float4 invRay = (float4)(1.0f, 1.0f, 1.0f, 1.0f) / rayDir;
-    float4 posInts = invRay * (bbMax - rayOrg);
-    float4 negInts = invRay * (bbMin - rayOrg);
-
-    float4 maxInts = max(posInts, negInts);
-    float4 minInts = min(posInts, negInts);
-
-    // Only two intersections will occur.
-    float maxInt = min(min(maxInts.x, maxInts.y), min(maxInts.x, maxInts.z));
-    float minInt = max(max(minInts.x, minInts.y), max(minInts.x, minInts.z));
-
-    *nPlane = minInt;
-    *fPlane = maxInt;
-
-    return maxInt > minInt;
-}
-
-kernel void render(
-    uint w_out, uint l_out, global uint *output,
-    uint depth, uint length, uint width, global uchar4 *data,
-    constant float *invMVTransposed)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-
-    float u = (x / (float)w_out) * 2.0f - 1.0f;
-    float v = (y / (float)l_out) * 2.0f - 1.0f;
-
-    float4 bbMin = (float4)(-1.0f, -1.0f, -1.0f, 1.0f);
-    float4 bbMax = (float4)(1.0f, 1.0f, 1.0f, 1.0f);
-
-    // Eye ray in MV space.
-    float4 eyerayOrg = (float4)(invMVTransposed[3], invMVTransposed[7], invMVTransposed[11], 1.0f);
-    float4 eyerayDir;
-
-    float4 acc = normalize(((float4)(u, v, -2.0f, 0.0f)));
-    eyerayDir.x = dot(acc, ((float4)(invMVTransposed[0], invMVTransposed[1], invMVTransposed[2], invMVTransposed[3])));
-    eyerayDir.y = dot(acc, ((float4)(invMVTransposed[4], invMVTransposed[5], invMVTransposed[6], invMVTransposed[7])));
-    eyerayDir.z = dot(acc, ((float4)(invMVTransposed[8], invMVTransposed[9], invMVTransposed[10], invMVTransposed[11])));
-    eyerayDir.w = 0.0f;
-
-    // Find intersection with BBox
-    float nPlane, fPlane;
-    if (!rayHitBBox(eyerayOrg, eyerayDir, bbMin, bbMax, &nPlane, &fPlane))
-    {
-        // Output black pixel
-        output[x + y * w_out] = 0;
-        return;
-    }
-
-    // Clamp nplane minimum to 0
-    nPlane *= sign(nPlane);
-
-    acc = (float4)(1.0f, 1.0f, 1.0f, 0.0f);
-    output[(y * w_out) + x] = 0;
-
-    float t = fPlane;
-    float4 scale = (float4)(depth, length, width, 1.0f);
-
-    // Raymarch back to front
-    float n = 1.0f;
-    uint stepLim = convert_uint(native_sqrt(convert_float(depth * depth + length * length + width * width + 1))) / 4;
-    float td = (fPlane - nPlane) / stepLim;
-    for (uint i = 0; i < stepLim; ++i)
-    {
-        float4 pos = eyerayOrg + eyerayDir * t;
-        t -= td;
-
-        pos = (pos * 0.5f + 0.5f) * scale;
-        uint4 iPos = clamp(convert_uint4_sat(pos), 0, convert_uint4_sat(scale - 1.0f));
-
-        uchar4 sample = data[iPos.x + iPos.y * depth + iPos.z * length * depth];
-
-        if ((sample.x | sample.y | sample.z | sample.w) == 0)
-        {
-            continue;
-        }
-
-        float4 sampleF = native_divide(convert_float4(sample), 255.0f);
-
-        // if (sample.w != 0)
-        // {
-        //     acc = mix(acc, sampleF, 1.0f / n);
-        //     n += 1.0f;
-        // }
-
-        // if (sample.x == sample.y && sample.x == sample.z)
-        // {
-        // acc.w = mix(acc.w, sampleF.w, 1.0f / n);
-        // n += 1.0f;
-        // }
-        // else
-        // {
-        //     sampleF.w = 1-native_sqrt(1-sampleF.w);
-        //     sampleF.xyz *= sampleF.w;
-        //     acc.xyz = acc.xyz*(1.0f - sampleF.w) + sampleF.xyz;
-        //     acc.w = acc.w*(1.0f - sampleF.w) + sampleF.w;
-        // }
-
-        // n += 1.0f;
-
-        // acc = mix(acc, sampleF, sampleF.w);
-
-        acc = mix(acc, sampleF, sampleF.w); // Interesting solid approach
-
-        if (t < nPlane)
-        {
-            break;
-        }
-    }
-
-    // Write to output buffer
-    uchar4 ut = convert_uchar4_sat(acc * 255.0f);
-    output[(y * w_out) + x] = ((uint)(ut.x) << 24) | ((uint)(ut.y) << 16) | (((uint)(ut.z)) << 8) | (uint)(ut.w);
-}
+// #define stepLim 500
+// #define td 0.01f
+
+int rayHitBBox(float4 rayOrg, float4 rayDir, float4 bbMin, float4 bbMax, float *nPlane, float *fPlane)
+{
+    // Ray intersections with BBox.
+    float4 invRay = (float4)(1.0f, 1.0f, 1.0f, 1.0f) / rayDir;
+    float4 posInts = invRay * (bbMax - rayOrg);
+    float4 negInts = invRay * (bbMin - rayOrg);
+
+    float4 maxInts = max(posInts, negInts);
+    float4 minInts = min(posInts, negInts);
+
+    // Only two intersections will occur.
+    float maxInt = min(min(maxInts.x, maxInts.y), min(maxInts.x, maxInts.z));
+    float minInt = max(max(minInts.x, minInts.y), max(minInts.x, minInts.z));
+
+    *nPlane = minInt;
+    *fPlane = maxInt;
+
+    return maxInt > minInt;
+}
+
+// Eye ray in MV space through pixel (x, y).
+void eyeRay(uint x, uint y, uint w_out, uint l_out, constant float *invMVTransposed, float4 *org, float4 *dir)
+{
+    float u = (x / (float)w_out) * 2.0f - 1.0f;
+    float v = (y / (float)l_out) * 2.0f - 1.0f;
+
+    *org = (float4)(invMVTransposed[3], invMVTransposed[7], invMVTransposed[11], 1.0f);
+
+    float4 acc = normalize(((float4)(u, v, -2.0f, 0.0f)));
+    (*dir).x = dot(acc, ((float4)(invMVTransposed[0], invMVTransposed[1], invMVTransposed[2], invMVTransposed[3])));
+    (*dir).y = dot(acc, ((float4)(invMVTransposed[4], invMVTransposed[5], invMVTransposed[6], invMVTransposed[7])));
+    (*dir).z = dot(acc, ((float4)(invMVTransposed[8], invMVTransposed[9], invMVTransposed[10], invMVTransposed[11])));
+    (*dir).w = 0.0f;
+}
+
+kernel void render(
+    uint w_out, uint l_out, global uint *output,
+    uint depth, uint length, uint width, global uchar4 *data,
+    constant float *invMVTransposed)
+{
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+
+    float4 bbMin = (float4)(-1.0f, -1.0f, -1.0f, 1.0f);
+    float4 bbMax = (float4)(1.0f, 1.0f, 1.0f, 1.0f);
+
+    float4 eyerayOrg, eyerayDir;
+    eyeRay(x, y, w_out, l_out, invMVTransposed, &eyerayOrg, &eyerayDir);
+    float4 acc;
+
+    // Find intersection with BBox
+    float nPlane, fPlane;
+    if (!rayHitBBox(eyerayOrg, eyerayDir, bbMin, bbMax, &nPlane, &fPlane))
+    {
+        // Output black pixel
+        output[x + y * w_out] = 0;
+        return;
+    }
+
+    // Clamp nplane minimum to 0
+    nPlane *= sign(nPlane);
+
+    acc = (float4)(1.0f, 1.0f, 1.0f, 0.0f);
+    output[(y * w_out) + x] = 0;
+
+    float t = fPlane;
+    float4 scale = (float4)(depth, length, width, 1.0f);
+
+    // Raymarch back to front
+    float n = 1.0f;
+    uint stepLim = convert_uint(native_sqrt(convert_float(depth * depth + length * length + width * width + 1))) / 4;
+    float td = (fPlane - nPlane) / stepLim;
+    for (uint i = 0; i < stepLim; ++i)
+    {
+        float4 pos = eyerayOrg + eyerayDir * t;
+        t -= td;
+
+        pos = (pos * 0.5f + 0.5f) * scale;
+        uint4 iPos = clamp(convert_uint4_sat(pos), 0, convert_uint4_sat(scale - 1.0f));
+
+        uchar4 sample = data[iPos.x + iPos.y * depth + iPos.z * length * depth];
+
+        if ((sample.x | sample.y | sample.z | sample.w) == 0)
+        {
+            continue;
+        }
+
+        float4 sampleF = native_divide(convert_float4(sample), 255.0f);
+
+        // if (sample.w != 0)
+        // {
+        //     acc = mix(acc, sampleF, 1.0f / n);
+        //     n += 1.0f;
+        // }
+
+        // if (sample.x == sample.y && sample.x == sample.z)
+        // {
+        // acc.w = mix(acc.w, sampleF.w, 1.0f / n);
+        // n += 1.0f;
+        // }
+        // else
+        // {
+        //     sampleF.w = 1-native_sqrt(1-sampleF.w);
+        //     sampleF.xyz *= sampleF.w;
+        //     acc.xyz = acc.xyz*(1.0f - sampleF.w) + sampleF.xyz;
+        //     acc.w = acc.w*(1.0f - sampleF.w) + sampleF.w;
+        // }
+
+        // n += 1.0f;
+
+        // acc = mix(acc, sampleF, sampleF.w);
+
+        acc = mix(acc, sampleF, sampleF.w); // Interesting solid approach
+
+        if (t < nPlane)
+        {
+            break;
+        }
+    }
+
+    // Write to output buffer
+    uchar4 ut = convert_uchar4_sat(acc * 255.0f);
+    output[(y * w_out) + x] = ((uint)(ut.x) << 24) | ((uint)(ut.y) << 16) | (((uint)(ut.z)) << 8) | (uint)(ut.w);
+}
+
+
+// Maps the render cube onto the fan's bounding box, in samples with the apex at the origin, ratio and angleDelta
+// as in sphericalTable. The nearest point along the axis is the corner of the first shell.
+typedef struct
+{
+    float near, far, halfAngle, halfExtent;
+    float3 centre;
+    bool is3D;
+} Fan;
+
+Fan makeFan(uint depth, uint width, float ratio, float angleDelta)
+{
+    Fan f;
+    f.is3D = width > 1;
+    f.halfAngle = angleDelta / 2.0f;
+    float spread = tan(f.halfAngle);
+    f.near = convert_float(depth) * ratio;
+    f.far = f.near + convert_float(depth) - 1.0f;
+    float x0 = f.near / sqrt(1.0f + spread * spread * (f.is3D ? 2.0f : 1.0f));
+    f.halfExtent = max(f.far - x0, 2.0f * f.far * sin(f.halfAngle)) / 2.0f;
+    f.centre = (float3)((x0 + f.far) / 2.0f, 0.0f, 0.0f);
+    return f;
+}
+
+// Continuous (beam, line, plane) coordinates of a cube position, false outside the fan.
+bool fanSample(Fan f, float4 pos, uint length, uint width, float3 *s)
+{
+    float3 p = f.centre + pos.xyz * f.halfExtent;
+    float R = f.is3D ? fast_length(p) : fast_length(p.xy);
+    float lAngle = atan2(p.y, p.x);
+    float wAngle = f.is3D ? atan2(p.z, p.x) : 0.0f;
+
+    *s = (float3)(
+        R - f.near,
+        (lAngle / f.halfAngle / 2.0f + 0.5f) * (length - 1.0f),
+        (wAngle / f.halfAngle / 2.0f + 0.5f) * (width - 1.0f));
+
+    return !(R < f.near || R > f.far || fabs(lAngle) > f.halfAngle || fabs(wAngle) > f.halfAngle);
+}
+
+uint packPixel(float4 acc)
+{
+    uchar4 ut = convert_uchar4_sat(acc * 255.0f);
+    return ((uint)(ut.x) << 24) | ((uint)(ut.y) << 16) | (((uint)(ut.z)) << 8) | (uint)(ut.w);
+}
+
+// Renders the acoustic (beam, line, plane) volume directly, each sample is mapped to (r, theta, phi) on the fly
+// instead of scan converting first.
+kernel void renderPolar(
+    uint w_out, uint l_out, global uint *output,
+    uint depth, uint length, uint width, global uchar4 *data,
+    constant float *invMVTransposed,
+    float ratio, float angleDelta)
+{
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+
+    float4 bbMin = (float4)(-1.0f, -1.0f, -1.0f, 1.0f);
+    float4 bbMax = (float4)(1.0f, 1.0f, 1.0f, 1.0f);
+
+    float4 eyerayOrg, eyerayDir;
+    eyeRay(x, y, w_out, l_out, invMVTransposed, &eyerayOrg, &eyerayDir);
+
+    float nPlane, fPlane;
+    if (!rayHitBBox(eyerayOrg, eyerayDir, bbMin, bbMax, &nPlane, &fPlane))
+    {
+        output[x + y * w_out] = 0;
+        return;
+    }
+
+    nPlane *= sign(nPlane);
+
+    Fan fan = makeFan(depth, width, ratio, angleDelta);
+
+    float4 acc = (float4)(1.0f, 1.0f, 1.0f, 0.0f);
+    float t = fPlane;
+
+    uint stepLim = convert_uint(native_sqrt(convert_float(depth * depth + length * length + width * width + 1))) / 4;
+    float td = (fPlane - nPlane) / stepLim;
+    for (uint i = 0; i < stepLim; ++i)
+    {
+        float4 pos = eyerayOrg + eyerayDir * t;
+        t -= td;
+
+        float3 s;
+        if (!fanSample(fan, pos, length, width, &s))
+        {
+            continue;
+        }
+
+        uint3 iPos = min(convert_uint3_sat(s), (uint3)(depth - 1, length - 1, width - 1));
+        uchar4 sample = data[iPos.x + iPos.y * depth + iPos.z * length * depth];
+
+        if ((sample.x | sample.y | sample.z | sample.w) == 0)
+        {
+            continue;
+        }
+
+        float4 sampleF = native_divide(convert_float4(sample), 255.0f);
+        acc = mix(acc, sampleF, sampleF.w);
+
+        if (t < nPlane)
+        {
+            break;
+        }
+    }
+
+    output[(y * w_out) + x] = packPixel(acc);
+}
+
+// Image variants of render and renderPolar: one filtered fetch per step replaces the nearest voxel. Unnormalised
+// coordinates put voxel centres on +0.5, the volume's frame is the first width slices of the image.
+constant sampler_t linearSampler = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_LINEAR;
+
+kernel void renderImage(
+    uint w_out, uint l_out, global uint *output,
+    uint depth, uint length, uint width, read_only image3d_t data,
+    constant float *invMVTransposed)
+{
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+
+    float4 bbMin = (float4)(-1.0f, -1.0f, -1.0f, 1.0f);
+    float4 bbMax = (float4)(1.0f, 1.0f, 1.0f, 1.0f);
+
+    float4 eyerayOrg, eyerayDir;
+    eyeRay(x, y, w_out, l_out, invMVTransposed, &eyerayOrg, &eyerayDir);
+
+    float nPlane, fPlane;
+    if (!rayHitBBox(eyerayOrg, eyerayDir, bbMin, bbMax, &nPlane, &fPlane))
+    {
+        output[x + y * w_out] = 0;
+        return;
+    }
+
+    nPlane *= sign(nPlane);
+
+    float4 acc = (float4)(1.0f, 1.0f, 1.0f, 0.0f);
+    float t = fPlane;
+    float4 scale = (float4)(depth, length, width, 1.0f);
+
+    uint stepLim = convert_uint(native_sqrt(convert_float(depth * depth + length * length + width * width + 1))) / 4;
+    float td = (fPlane - nPlane) / stepLim;
+    for (uint i = 0; i < stepLim; ++i)
+    {
+        float4 pos = eyerayOrg + eyerayDir * t;
+        t -= td;
+
+        pos = (pos * 0.5f + 0.5f) * scale;
+        float4 sampleF = read_imagef(data, linearSampler, (float4)(pos.xyz, 0.0f));
+
+        // Fully transparent samples leave acc as it is
+        acc = mix(acc, sampleF, sampleF.w);
+
+        if (t < nPlane)
+        {
+            break;
+        }
+    }
+
+    output[(y * w_out) + x] = packPixel(acc);
+}
+
+kernel void renderPolarImage(
+    uint w_out, uint l_out, global uint *output,
+    uint depth, uint length, uint width, read_only image3d_t data,
+    constant float *invMVTransposed,
+    float ratio, float angleDelta)
+{
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+
+    float4 bbMin = (float4)(-1.0f, -1.0f, -1.0f, 1.0f);
+    float4 bbMax = (float4)(1.0f, 1.0f, 1.0f, 1.0f);
+
+    float4 eyerayOrg, eyerayDir;
+    eyeRay(x, y, w_out, l_out, invMVTransposed, &eyerayOrg, &eyerayDir);
+
+    float nPlane, fPlane;
+    if (!rayHitBBox(eyerayOrg, eyerayDir, bbMin, bbMax, &nPlane, &fPlane))
+    {
+        output[x + y * w_out] = 0;
+        return;
+    }
+
+    nPlane *= sign(nPlane);
+
+    Fan fan = makeFan(depth, width, ratio, angleDelta);
+
+    float4 acc = (float4)(1.0f, 1.0f, 1.0f, 0.0f);
+    float t = fPlane;
+
+    uint stepLim = convert_uint(native_sqrt(convert_float(depth * depth + length * length + width * width + 1))) / 4;
+    float td = (fPlane - nPlane) / stepLim;
+    for (uint i = 0; i < stepLim; ++i)
+    {
+        float4 pos = eyerayOrg + eyerayDir * t;
+        t -= td;
+
+        float3 s;
+        if (!fanSample(fan, pos, length, width, &s))
+        {
+            continue;
+        }
+
+        float4 sampleF = read_imagef(data, linearSampler, (float4)(s + 0.5f, 0.0f));
+        acc = mix(acc, sampleF, sampleF.w);
+
+        if (t < nPlane)
+        {
+            break;
+        }
+    }
+
+    output[(y * w_out) + x] = packPixel(acc);
+}
\ No newline at end of file
@@ -1,358 +1,839 @@
-kernel void slice(
-    uint depth, uint length, uint width, global uint *input, global uint *output,
-    uint dNum, uint lNum, uint wNum, constant float *slices)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    output[x + y * depth + z * depth * length] = 0;
-
-    for (uint i = 0; i < dNum; ++i)
-    {
-        float dSlice = slices[i] * convert_float(depth);
-        if (fabs(convert_float(x) - dSlice) < 3.0f)
-        {
-            output[x + y * depth + z * depth * length] = input[x + y * depth + z * depth * length];
-            return;
-        }
-    }
-
-    for (uint i = 0; i < lNum; ++i)
-    {
-        float lSlice = slices[dNum + i] * convert_float(length);
-        if (fabs(convert_float(y) - lSlice) < 3.0f)
-        {
-            output[x + y * depth + z * depth * length] = input[x + y * depth + z * depth * length];
-            return;
-        }
-    }
-
-    for (uint i = 0; i < wNum; ++i)
-    {
-        float wSlice = slices[dNum + lNum + i] * convert_float(width);
-        if (fabs(convert_float(z) - wSlice) < 3.0f)
-        {
-            output[x + y * depth + z * depth * length] = input[x + y * depth + z * depth * length];
-            return;
-        }
-    }
-}
-
-kernel void clamping(
-    uint depth, uint length, uint width, global uint *input, global uint *output,
-    float dl, float du, float ll, float lu, float wl, float wu)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint offset = x + y * depth + z * depth * length;
-
-    output[offset] = 0;
-
-    if (
-        x > dl * depth && x < du * depth &&
-        y > ll * length && y < lu * length &&
-        z > wl * width && z < wu * width)
-    {
-        output[offset] = input[offset];
-    }
-}
-
-kernel void threshold(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, uchar val)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint offset = x + y * depth + z * length * depth;
-    if (input[offset].w > val)
-    {
-        output[offset] = input[offset];
-        // output[offset].w = 0xFF;
-    }
-    else if (input[offset].w > 0x00)
-    {
-        output[offset] = (uchar4)(0x00, 0x00, 0x00, 0x00);
-    }
-    else
-    {
-        output[offset] = (uchar4)(0x00, 0x00, 0x00, 0x00);
-    }
-}
-
-kernel void invert(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint offset = x + y * depth + z * length * depth;
-    output[offset] = input[offset];
-    output[offset].x = 0xFF - output[offset].x;
-    output[offset].y = 0xFF - output[offset].y;
-    output[offset].z = 0xFF - output[offset].z;
-    output[offset].w = clamp(0xFF - output[offset].w, 0x01, 0xFF);
-}
-
-kernel void contrast(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, uchar minim, uchar maxim)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint offset = x + y * depth + z * length * depth;
-
-    float mdiff = convert_float(maxim - minim);
-    float vdiff = convert_float(input[offset].w - minim);
-
-    output[offset] = input[offset];
-    output[offset].w = convert_uchar(clamp(vdiff / mdiff * 255.0f, 0.0f, 255.0f));
-}
-
-kernel void logTwo(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint offset = x + y * depth + z * length * depth;
-
-    output[offset] = input[offset];
-    output[offset].w = convert_uchar(native_log2(1.0f + convert_float(input[offset].w) / 255.0f) * 255.0f);
-}
-
-kernel void square(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint offset = x + y * depth + z * length * depth;
-
-    output[offset] = input[offset];
-    output[offset].w = convert_uchar(native_sqrt(convert_float(input[offset].w) / 255.0f) * 255.0f);
-}
-
-kernel void shrink(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint lOff = y * depth;
-    uint wOff = z * depth * length;
-    uint offset = x + lOff + wOff;
-
-    uint dlim = depth - 1;
-    uint llim = (length - 1) * depth;
-    uint wlim = (width - 1) * (length * depth);
-
-    output[offset] = input[offset];
-
-    for (int i = 1; i <= 3; ++i)
-    {
-        if (
-            input[clamp(offset - i, (uint)(0), dlim)].w == 0x00 ||
-            input[clamp(offset + i, (uint)(0), dlim)].w == 0x00 ||
-            input[clamp(offset - depth * i, (uint)(0), llim)].w == 0x00 ||
-            input[clamp(offset + depth * i, (uint)(0), llim)].w == 0x00 ||
-            input[clamp(offset - depth * length * i, (uint)(0), wlim)].w == 0x00 ||
-            input[clamp(offset + depth * length * i, (uint)(0), wlim)].w == 0x00)
-        {
-            output[offset].w = 0x00;
-            break;
-        }
-    }
-}
-
-kernel void fade(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint offset = x + y * depth + z * depth * length;
-
-    output[offset] = input[offset];
-
-    if (output[offset].x == output[offset].y && output[offset].x == output[offset].z) // Not Doppler data
-    {
-        output[offset].w = input[offset].w / 2;
-    }
-}
-
-kernel void colourise(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output,
-    float red, float green, float blue)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint offset = x + y * depth + z * depth * length;
-
-    output[offset] = input[offset];
-
-    output[offset].x = convert_uchar(mix(red, convert_float(input[offset].x) / 255.0f, convert_float(input[offset].w) / 255.0f) * 255.0f);
-    output[offset].y = convert_uchar(mix(green, convert_float(input[offset].y) / 255.0f, convert_float(input[offset].w) / 255.0f) * 255.0f);
-    output[offset].z = convert_uchar(mix(blue, convert_float(input[offset].z) / 255.0f, convert_float(input[offset].w) / 255.0f) * 255.0f);
-    // output[offset].y = (1.0f - convert_float(input[offset].w)/255.0f)*green;
-    // output[offset].z = (1.0f - convert_float(input[offset].w)/255.0f)*blue;
-}
-
-kernel void medianNoise2D(
-    uint depth, uint length, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-
-    uint offset = x + y * depth;
-
-    uint size = depth * length;
-    uint start = clamp(x - 1, (uint)0, depth) + clamp(y - 1, (uint)0, length) * depth;
-
-    uchar pixels[9];
-
-    for (uint i = 0; i < 3; ++i)
-    {
-        for (uint j = 0; j < 3; ++j)
-        {
-            pixels[j + i * 3] = input[min(start + j + i * depth, size - 1)].w;
-        }
-    }
-
-    for (uint i = 0; i < 8; ++i)
-    {
-        for (uint j = 0; j < 8 - i; ++j)
-        {
-            uchar t = max(pixels[j], pixels[j + 1]);
-            pixels[j] = min(pixels[j], pixels[j + 1]);
-            pixels[j + 1] = t;
-        }
-    }
-
-    output[offset] = pixels[4];
-}
-
-kernel void medianNoise3D(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint lOff = y * depth;
-    uint wOff = z * depth * length;
-    uint offset = x + lOff + wOff;
-
-    uint size = depth * length * width;
-    uint start = clamp(x - 1, (uint)0, depth) + clamp(y - 1, (uint)0, length) * depth + clamp(z - 1, (uint)0, width) * depth * length;
-
-    uchar pixels[27];
-
-    for (uint i = 0; i < 3; ++i)
-    {
-        for (uint j = 0; j < 3; ++j)
-        {
-            for (uint k = 0; k < 3; ++k)
-            {
-                pixels[k + j * 3 + i * 9] = input[min(start + k + j * depth + i * depth * length, size - 1)].w;
-            }
-        }
-    }
-
-    for (uint i = 0; i < 26; ++i)
-    {
-        for (uint j = 0; j < 26 - i; ++j)
-        {
-            uchar t = max(pixels[j], pixels[j + 1]);
-            pixels[j] = min(pixels[j], pixels[j + 1]);
-            pixels[j + 1] = t;
-        }
-    }
-
-    output[offset] = pixels[13];
-}
-
-kernel void gaussian2D(
-    uint depth, uint length, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-
-    uint offset = x + y * depth;
-
-    const float weights[9] = {0.0162162162, 0.0540540541, 0.1216216216, 0.1945945946, 0.2270270270, 0.1945945946, 0.1216216216, 0.0540540541, 0.0162162162};
-
-    float out = 3.0f * convert_float(input[offset].w) / 255.0f * weights[0];
-
-    uint size = depth * length;
-
-    uint start = clamp(x - 5, (uint)0, depth - 1) + y * depth;
-    float outX = out;
-    for (uint i = 1; i < 9; ++i)
-    {
-        outX += convert_float(input[min(start + i, size - 1)].w) / 255.0f * weights[i];
-    }
-
-    start = x + clamp(y - 5, (uint)0, length - 1) * depth;
-    float outY = out;
-    for (uint i = 1; i < 9; ++i)
-    {
-        outY += convert_float(input[min(start + i * depth, size - 1)].w) / 255.0f * weights[i];
-    }
-
-    output[offset] = input[offset];
-    output[offset].w = convert_uchar(clamp((outY * outX), 0.0f, 1.0f) * 255.0f);
-}
-
-kernel void gaussian3D(
-    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
-{
-    uint x = get_global_id(0);
-    uint y = get_global_id(1);
-    uint z = get_global_id(2);
-
-    uint lOff = y * depth;
-    uint wOff = z * depth * length;
-    uint offset = x + lOff + wOff;
-
-    const float weights[9] = {0.0162162162, 0.0540540541, 0.1216216216, 0.1945945946, 0.2270270270, 0.1945945946, 0.1216216216, 0.0540540541, 0.0162162162};
-
-    float out = 3.0f * convert_float(input[offset].w) / 255.0f * weights[0];
-
-    uint size = depth * length * width;
-
-    uint start = clamp(x - 5, (uint)0, depth - 1) + y * depth + z * depth * length;
-    float outX = out;
-    for (uint i = 1; i < 9; ++i)
-    {
-        outX += convert_float(input[min(start + i, size - 1)].w) / 255.0f * weights[i];
-    }
-
-    start = x + clamp(y - 5, (uint)0, length - 1) * depth + z * depth * length;
-    float outY = out;
-    for (uint i = 1; i < 9; ++i)
-    {
-        outY += convert_float(input[min(start + i * depth, size - 1)].w) / 255.0f * weights[i];
-    }
-
-    start = x + y * depth + clamp(z - 5, (uint)0, width - 1) * depth * length;
-    float outZ = out;
-    for (uint i = 1; i < 9; ++i)
-    {
-        outZ += convert_float(input[min(start + i * depth * length, size - 1)].w) / 255.0f * weights[i];
-    }
-
-    output[offset] = input[offset];
-    output[offset].w = convert_uchar(clamp((outZ * outY * outX), 0.0f, 1.0f) * 255.0f);
+// Specialised builds pass -DDEPTH, -DLENGTH and -DWIDTH, the dimension arguments are then replaced by
+// constants so indexing and bounds fold at compile time.
+#ifdef DEPTH
+#define SPECIALISE(d, l, w) \
+    d = DEPTH;              \
+    l = LENGTH;             \
+    w = WIDTH
+#define SPECIALISE2D(d, l) \
+    d = DEPTH;             \
+    l = LENGTH
+#else
+#define SPECIALISE(d, l, w)
+#define SPECIALISE2D(d, l)
+#endif
+
+// Tiled stencils. A work-group stages the .w channel of its block plus a halo of r voxels (clamped to the
+// volume edge) in local memory, so each voxel is fetched from global memory about once instead of once per
+// tap. Global sizes are padded to whole groups per frame, items past the edge only help with the load.
+typedef struct
+{
+    int3 pos;    // Voxel within the frame
+    int3 dims;   // Tile size including the halo
+    int r;       // Halo radius
+    uint frame;  // Offset of the frame within the batch, in voxels
+    bool inside; // pos lies within the volume
+} Tile;
+
+inline Tile loadTile(local uchar *tile, global const uchar4 *input, uint depth, uint length, uint width, int r)
+{
+    int3 lsize = (int3)((int)get_local_size(0), (int)get_local_size(1), (int)get_local_size(2));
+    int3 lid = (int3)((int)get_local_id(0), (int)get_local_id(1), (int)get_local_id(2));
+
+    // Frames of a batch are stacked along z in whole groups
+    uint zGroups = (width + lsize.z - 1) / lsize.z;
+    int3 origin = (int3)((int)get_group_id(0), (int)get_group_id(1), (int)(get_group_id(2) % zGroups)) * lsize;
+
+    Tile t;
+    t.pos = origin + lid;
+    t.dims = lsize + 2 * r;
+    t.r = r;
+    t.frame = (get_group_id(2) / zGroups) * depth * length * width;
+    t.inside = t.pos.x < (int)depth && t.pos.y < (int)length && t.pos.z < (int)width;
+
+    input += t.frame;
+    origin -= r;
+
+    int3 hi = (int3)(depth - 1, length - 1, width - 1);
+    int count = t.dims.x * t.dims.y * t.dims.z;
+    for (int i = lid.x + lid.y * lsize.x + lid.z * lsize.x * lsize.y; i < count; i += lsize.x * lsize.y * lsize.z)
+    {
+        int3 p = (int3)(i % t.dims.x, (i / t.dims.x) % t.dims.y, i / (t.dims.x * t.dims.y));
+        int3 g = clamp(origin + p, (int3)(0), hi);
+        tile[i] = input[g.x + g.y * depth + g.z * depth * length].w;
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+    return t;
+}
+
+inline uchar tileAt(local const uchar *tile, Tile t, int dx, int dy, int dz)
+{
+    int3 p = (int3)((int)get_local_id(0), (int)get_local_id(1), (int)get_local_id(2)) + t.r + (int3)(dx, dy, dz);
+    return tile[p.x + p.y * t.dims.x + p.z * t.dims.x * t.dims.y];
+}
+
+kernel void slice(
+    uint depth, uint length, uint width, global uint *input, global uint *output,
+    uint dNum, uint lNum, uint wNum, constant float *slices)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2) % width; // Frames of a batch are stacked along z
+
+    uint frame = get_global_id(2) / width;
+    input += frame * depth * length * width;
+    output += frame * depth * length * width;
+
+    output[x + y * depth + z * depth * length] = 0;
+
+    for (uint i = 0; i < dNum; ++i)
+    {
+        float dSlice = slices[i] * convert_float(depth);
+        if (fabs(convert_float(x) - dSlice) < 3.0f)
+        {
+            output[x + y * depth + z * depth * length] = input[x + y * depth + z * depth * length];
+            return;
+        }
+    }
+
+    for (uint i = 0; i < lNum; ++i)
+    {
+        float lSlice = slices[dNum + i] * convert_float(length);
+        if (fabs(convert_float(y) - lSlice) < 3.0f)
+        {
+            output[x + y * depth + z * depth * length] = input[x + y * depth + z * depth * length];
+            return;
+        }
+    }
+
+    for (uint i = 0; i < wNum; ++i)
+    {
+        float wSlice = slices[dNum + lNum + i] * convert_float(width);
+        if (fabs(convert_float(z) - wSlice) < 3.0f)
+        {
+            output[x + y * depth + z * depth * length] = input[x + y * depth + z * depth * length];
+            return;
+        }
+    }
+}
+
+kernel void clamping(
+    uint depth, uint length, uint width, global uint *input, global uint *output,
+    float dl, float du, float ll, float lu, float wl, float wu)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2) % width; // Frames of a batch are stacked along z
+
+    uint frame = get_global_id(2) / width;
+    input += frame * depth * length * width;
+    output += frame * depth * length * width;
+
+    uint offset = x + y * depth + z * depth * length;
+
+    output[offset] = 0;
+
+    if (
+        x > dl * depth && x < du * depth &&
+        y > ll * length && y < lu * length &&
+        z > wl * width && z < wu * width)
+    {
+        output[offset] = input[offset];
+    }
+}
+
+kernel void threshold(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, uchar val)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2);
+
+    uint offset = x + y * depth + z * length * depth;
+    if (input[offset].w > val)
+    {
+        output[offset] = input[offset];
+        // output[offset].w = 0xFF;
+    }
+    else if (input[offset].w > 0x00)
+    {
+        output[offset] = (uchar4)(0x00, 0x00, 0x00, 0x00);
+    }
+    else
+    {
+        output[offset] = (uchar4)(0x00, 0x00, 0x00, 0x00);
+    }
+}
+
+kernel void invert(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2);
+
+    uint offset = x + y * depth + z * length * depth;
+    output[offset] = input[offset];
+    output[offset].x = 0xFF - output[offset].x;
+    output[offset].y = 0xFF - output[offset].y;
+    output[offset].z = 0xFF - output[offset].z;
+    output[offset].w = clamp(0xFF - output[offset].w, 0x01, 0xFF);
+}
+
+kernel void contrast(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, uchar minim, uchar maxim)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2);
+
+    uint offset = x + y * depth + z * length * depth;
+
+    float mdiff = convert_float(maxim - minim);
+    float vdiff = convert_float(input[offset].w - minim);
+
+    output[offset] = input[offset];
+    output[offset].w = convert_uchar(clamp(vdiff / mdiff * 255.0f, 0.0f, 255.0f));
+}
+
+kernel void logTwo(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2);
+
+    uint offset = x + y * depth + z * length * depth;
+
+    output[offset] = input[offset];
+    output[offset].w = convert_uchar(native_log2(1.0f + convert_float(input[offset].w) / 255.0f) * 255.0f);
+}
+
+kernel void square(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2);
+
+    uint offset = x + y * depth + z * length * depth;
+
+    output[offset] = input[offset];
+    output[offset].w = convert_uchar(native_sqrt(convert_float(input[offset].w) / 255.0f) * 255.0f);
+}
+
+kernel void shrink(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, local uchar *tile)
+{
+    SPECIALISE(depth, length, width);
+
+    Tile t = loadTile(tile, input, depth, length, width, 3);
+    if (!t.inside)
+        return;
+
+    uint offset = t.frame + t.pos.x + t.pos.y * depth + t.pos.z * depth * length;
+
+    output[offset] = input[offset];
+
+    for (int i = 1; i <= 3; ++i)
+    {
+        if (
+            tileAt(tile, t, -i, 0, 0) == 0x00 ||
+            tileAt(tile, t, i, 0, 0) == 0x00 ||
+            tileAt(tile, t, 0, -i, 0) == 0x00 ||
+            tileAt(tile, t, 0, i, 0) == 0x00 ||
+            tileAt(tile, t, 0, 0, -i) == 0x00 ||
+            tileAt(tile, t, 0, 0, i) == 0x00)
+        {
+            output[offset].w = 0x00;
+            break;
+        }
+    }
+}
+
+kernel void fade(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2);
+
+    uint offset = x + y * depth + z * depth * length;
+
+    output[offset] = input[offset];
+
+    if (output[offset].x == output[offset].y && output[offset].x == output[offset].z) // Not Doppler data
+    {
+        output[offset].w = input[offset].w / 2;
+    }
+}
+
+kernel void colourise(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output,
+    float red, float green, float blue)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2);
+
+    uint offset = x + y * depth + z * depth * length;
+
+    output[offset] = input[offset];
+
+    output[offset].x = convert_uchar(mix(red, convert_float(input[offset].x) / 255.0f, convert_float(input[offset].w) / 255.0f) * 255.0f);
+    output[offset].y = convert_uchar(mix(green, convert_float(input[offset].y) / 255.0f, convert_float(input[offset].w) / 255.0f) * 255.0f);
+    output[offset].z = convert_uchar(mix(blue, convert_float(input[offset].z) / 255.0f, convert_float(input[offset].w) / 255.0f) * 255.0f);
+    // output[offset].y = (1.0f - convert_float(input[offset].w)/255.0f)*green;
+    // output[offset].z = (1.0f - convert_float(input[offset].w)/255.0f)*blue;
+}
+
+// Wide variants of the pointwise kernels for CPU devices, same arguments plus the voxel count (frames of a
+// batch are contiguous, so it includes them) and the voxels per work-item. Voxels move four at a time as a
+// uchar16 with the .w channels in lanes 3, 7, 11 and 15, a work-item is a run of straight vector ops.
+typedef union
+{
+    uchar16 v;
+    uchar4 q[4];
+} Quad;
+
+inline Quad loadQuad(global const uchar4 *p, uint i, uint count)
+{
+    Quad q;
+    if (i + 4 <= count)
+    {
+        q.v = vload16(0, (global const uchar *)(p + i));
+    }
+    else
+    {
+        for (uint n = 0; n < 4; ++n)
+            q.q[n] = i + n < count ? p[i + n] : (uchar4)(0);
+    }
+    return q;
+}
+
+inline void storeQuad(Quad q, global uchar4 *p, uint i, uint count)
+{
+    if (i + 4 <= count)
+    {
+        vstore16(q.v, 0, (global uchar *)(p + i));
+    }
+    else
+    {
+        for (uint n = 0; i + n < count; ++n)
+            p[i + n] = q.q[n];
+    }
+}
+
+kernel void thresholdWide(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, uchar val,
+    uint count, uint voxels)
+{
+    uint first = get_global_id(0) * voxels;
+    uint last = min(first + voxels, count);
+    for (uint i = first; i < last; i += 4)
+    {
+        Quad q = loadQuad(input, i, count);
+        uchar4 keep = as_uchar4(q.v.s37bf > (uchar4)(val));
+        q.v &= (uchar16)(keep.s0000, keep.s1111, keep.s2222, keep.s3333);
+        storeQuad(q, output, i, count);
+    }
+}
+
+kernel void invertWide(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output,
+    uint count, uint voxels)
+{
+    uint first = get_global_id(0) * voxels;
+    uint last = min(first + voxels, count);
+    for (uint i = first; i < last; i += 4)
+    {
+        Quad q = loadQuad(input, i, count);
+        q.v = (uchar16)(0xFF) - q.v;
+        q.v.s37bf = max(q.v.s37bf, (uchar4)(0x01));
+        storeQuad(q, output, i, count);
+    }
+}
+
+kernel void contrastWide(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, uchar minim, uchar maxim,
+    uint count, uint voxels)
+{
+    float mdiff = convert_float(maxim - minim);
+
+    uint first = get_global_id(0) * voxels;
+    uint last = min(first + voxels, count);
+    for (uint i = first; i < last; i += 4)
+    {
+        Quad q = loadQuad(input, i, count);
+        float4 vdiff = convert_float4(convert_int4(q.v.s37bf) - (int)minim);
+        q.v.s37bf = convert_uchar4(clamp(vdiff / mdiff * 255.0f, 0.0f, 255.0f));
+        storeQuad(q, output, i, count);
+    }
+}
+
+kernel void logTwoWide(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output,
+    uint count, uint voxels)
+{
+    uint first = get_global_id(0) * voxels;
+    uint last = min(first + voxels, count);
+    for (uint i = first; i < last; i += 4)
+    {
+        Quad q = loadQuad(input, i, count);
+        q.v.s37bf = convert_uchar4(native_log2(1.0f + convert_float4(q.v.s37bf) / 255.0f) * 255.0f);
+        storeQuad(q, output, i, count);
+    }
+}
+
+kernel void squareWide(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output,
+    uint count, uint voxels)
+{
+    uint first = get_global_id(0) * voxels;
+    uint last = min(first + voxels, count);
+    for (uint i = first; i < last; i += 4)
+    {
+        Quad q = loadQuad(input, i, count);
+        q.v.s37bf = convert_uchar4(native_sqrt(convert_float4(q.v.s37bf) / 255.0f) * 255.0f);
+        storeQuad(q, output, i, count);
+    }
+}
+
+kernel void fadeWide(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output,
+    uint count, uint voxels)
+{
+    uint first = get_global_id(0) * voxels;
+    uint last = min(first + voxels, count);
+    for (uint i = first; i < last; i += 4)
+    {
+        Quad q = loadQuad(input, i, count);
+        char4 grey = (q.v.s048c == q.v.s159d) & (q.v.s048c == q.v.s26ae); // Not Doppler data
+        q.v.s37bf = select(q.v.s37bf, q.v.s37bf / (uchar4)(2), grey);
+        storeQuad(q, output, i, count);
+    }
+}
+
+kernel void colouriseWide(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output,
+    float red, float green, float blue, uint count, uint voxels)
+{
+    uint first = get_global_id(0) * voxels;
+    uint last = min(first + voxels, count);
+    for (uint i = first; i < last; i += 4)
+    {
+        Quad q = loadQuad(input, i, count);
+        float4 a = convert_float4(q.v.s37bf) / 255.0f;
+        q.v.s048c = convert_uchar4(mix((float4)(red), convert_float4(q.v.s048c) / 255.0f, a) * 255.0f);
+        q.v.s159d = convert_uchar4(mix((float4)(green), convert_float4(q.v.s159d) / 255.0f, a) * 255.0f);
+        q.v.s26ae = convert_uchar4(mix((float4)(blue), convert_float4(q.v.s26ae) / 255.0f, a) * 255.0f);
+        storeQuad(q, output, i, count);
+    }
+}
+
+// Median by forgetful selection: the window starts with (n + 3) / 2 taps, each further tap replaces the
+// window's minimum after its maximum is dropped, which can never discard the median. Branchless min/max
+// only, so it maps to a selection network once the radius is fixed. Up to n = 125 taps (r = 2 in 3D).
+#define MEDIAN_WINDOW 64
+
+inline void dropExtremes(uchar *window, uint k)
+{
+    for (uint i = 1; i < k; ++i)
+    {
+        uchar lo = min(window[0], window[i]);
+        window[i] = max(window[0], window[i]);
+        window[0] = lo;
+    }
+    for (uint i = 1; i < k - 1; ++i)
+    {
+        uchar hi = max(window[i], window[k - 1]);
+        window[i] = min(window[i], window[k - 1]);
+        window[k - 1] = hi;
+    }
+}
+
+kernel void medianNetwork(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, local uchar *tile, uint radius)
+{
+    SPECIALISE(depth, length, width);
+
+    Tile t = loadTile(tile, input, depth, length, width, radius);
+    if (!t.inside)
+        return;
+
+    uint offset = t.frame + t.pos.x + t.pos.y * depth + t.pos.z * depth * length;
+
+    int r = radius;
+    int rz = width == 1 ? 0 : r;
+    uint n = (2 * r + 1) * (2 * r + 1) * (2 * rz + 1);
+    uint k = (n + 3) / 2;
+
+    uchar window[MEDIAN_WINDOW];
+    uint filled = 0;
+
+    for (int dz = -rz; dz <= rz; ++dz)
+    {
+        for (int dy = -r; dy <= r; ++dy)
+        {
+            for (int dx = -r; dx <= r; ++dx)
+            {
+                uchar v = tileAt(tile, t, dx, dy, dz);
+                if (filled < k)
+                {
+                    window[filled++] = v;
+                    continue;
+                }
+
+                dropExtremes(window, k);
+                --k;
+                window[0] = window[k - 1];
+                window[k - 1] = v;
+            }
+        }
+    }
+
+    dropExtremes(window, k);
+    output[offset] = window[1];
+}
+
+// Huang's sliding histogram for larger radii, a work-item walks one line along the depth axis. Moving one
+// voxel swaps a plane of (2r + 1)^2 taps in and out, the median is tracked from the previous one.
+inline void histPlane(
+    ushort *hist, global const uchar4 *input, uint depth, uint length, uint width,
+    int x, int y, int z, int r, int rz, int sign, uchar m, int *below)
+{
+    x = clamp(x, 0, (int)depth - 1);
+    for (int dz = -rz; dz <= rz; ++dz)
+    {
+        int zz = clamp(z + dz, 0, (int)width - 1);
+        for (int dy = -r; dy <= r; ++dy)
+        {
+            int yy = clamp(y + dy, 0, (int)length - 1);
+            uchar v = input[x + yy * depth + zz * depth * length].w;
+            hist[v] += sign;
+            *below += v < m ? sign : 0;
+        }
+    }
+}
+
+kernel void medianHistogram(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar4 *output, uint radius)
+{
+    SPECIALISE(depth, length, width);
+
+    uint y = get_global_id(0);
+    uint z = get_global_id(1) % width; // Frames of a batch are stacked along z
+
+    uint frame = get_global_id(1) / width;
+    input += frame * depth * length * width;
+    output += frame * depth * length * width;
+
+    int r = radius;
+    int rz = width == 1 ? 0 : r;
+    int rank = (2 * r + 1) * (2 * r + 1) * (2 * rz + 1) / 2;
+
+    ushort hist[256];
+    for (uint i = 0; i < 256; ++i)
+        hist[i] = 0;
+
+    uchar m = 0;
+    int below = 0;
+    for (int dx = -r; dx <= r; ++dx)
+        histPlane(hist, input, depth, length, width, dx, y, z, r, rz, 1, m, &below);
+
+    for (int x = 0; x < (int)depth; ++x)
+    {
+        if (x > 0)
+        {
+            histPlane(hist, input, depth, length, width, x - r - 1, y, z, r, rz, -1, m, &below);
+            histPlane(hist, input, depth, length, width, x + r, y, z, r, rz, 1, m, &below);
+        }
+
+        // Move m until exactly rank taps lie below it and m itself covers the rank
+        while (below > rank)
+        {
+            --m;
+            below -= hist[m];
+        }
+        while (below + hist[m] <= rank)
+        {
+            below += hist[m];
+            ++m;
+        }
+
+        output[x + y * depth + z * depth * length] = m;
+    }
+}
+
+// Recursive Gaussian (Young and van Vliet, 1995), cost per voxel is independent of sigma. The .w channel is
+// widened to float, filtered in place one axis at a time with a work-item per line, then narrowed again.
+kernel void alphaToFloat(
+    uint depth, uint length, uint width, global uchar4 *input, global float *output)
+{
+    uint i = get_global_id(0);
+    output[i] = convert_float(input[i].w);
+}
+
+kernel void floatToAlpha(
+    uint depth, uint length, uint width, global uchar4 *input, global float *alpha, global uchar4 *output)
+{
+    uint i = get_global_id(0);
+    output[i] = input[i];
+    output[i].w = convert_uchar_sat_rte(alpha[i]);
+}
+
+// c = (B, b1/b0, b2/b0, b3/b0). Axis 0 and 1 lines are indexed by (other axis, z + frame * width), axis 2
+// lines by (x, y + frame * length). Reads input and writes output, so running it again gives the same result.
+kernel void gaussianIIR(
+    uint depth, uint length, uint width, global const float *input, global float *output, uint axis, float4 c)
+{
+    SPECIALISE(depth, length, width);
+
+    uint a = get_global_id(0);
+    uint b = get_global_id(1);
+
+    uint n, stride, start;
+    if (axis == 0)
+    {
+        n = depth;
+        stride = 1;
+        start = a * depth + b * depth * length;
+    }
+    else if (axis == 1)
+    {
+        n = length;
+        stride = depth;
+        start = a + b * depth * length;
+    }
+    else
+    {
+        n = width;
+        stride = depth * length;
+        start = a + (b % length) * depth + (b / length) * depth * length * width;
+    }
+    input += start;
+    global float *line = output + start;
+
+    // Causal pass, history starts at the edge value (replicated border)
+    float w1 = input[0], w2 = w1, w3 = w1;
+    for (uint i = 0; i < n; ++i)
+    {
+        float w = c.x * input[i * stride] + c.y * w1 + c.z * w2 + c.w * w3;
+        line[i * stride] = w;
+        w3 = w2;
+        w2 = w1;
+        w1 = w;
+    }
+
+    // Anti-causal pass, in place over this work-item's own output line
+    float y1 = line[(n - 1) * stride], y2 = y1, y3 = y1;
+    for (uint i = n; i-- > 0;)
+    {
+        float y = c.x * line[i * stride] + c.y * y1 + c.z * y2 + c.w * y3;
+        line[i * stride] = y;
+        y3 = y2;
+        y2 = y1;
+        y1 = y;
+    }
+}
+
+// Morphology on the .w channel, separable van Herk/Gil-Werman passes so the cost per voxel is independent of
+// the radius. Lines are addressed like gaussianIIR and extended by r replicated voxels at each end.
+kernel void extractAlpha(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar *output)
+{
+    uint i = get_global_id(0);
+    output[i] = input[i].w;
+}
+
+kernel void insertAlpha(
+    uint depth, uint length, uint width, global uchar4 *input, global uchar *alpha, global uchar4 *output)
+{
+    uint i = get_global_id(0);
+    output[i] = input[i];
+    output[i].w = alpha[i];
+}
+
+// scratch holds n + 2r values per line, for the suffix extrema of every block of 2r + 1.
+kernel void morphologyLine(
+    uint depth, uint length, uint width, global uchar *input, global uchar *output, global uchar *scratch,
+    uint axis, uint radius, uint dilate)
+{
+    SPECIALISE(depth, length, width);
+
+    uint a = get_global_id(0);
+    uint b = get_global_id(1);
+
+    uint n, stride, start;
+    if (axis == 0)
+    {
+        n = depth;
+        stride = 1;
+        start = a * depth + b * depth * length;
+    }
+    else if (axis == 1)
+    {
+        n = length;
+        stride = depth;
+        start = a + b * depth * length;
+    }
+    else
+    {
+        n = width;
+        stride = depth * length;
+        start = a + (b % length) * depth + (b / length) * depth * length * width;
+    }
+    input += start;
+    output += start;
+
+    int r = radius;
+    uint k = 2 * radius + 1;
+    uint ext = n + 2 * radius;
+    global uchar *h = scratch + (a + b * get_global_size(0)) * ext;
+
+    // Suffix extrema within each block
+    for (uint j = ext; j-- > 0;)
+    {
+        uchar v = input[clamp((int)j - r, 0, (int)n - 1) * stride];
+        h[j] = ((j + 1) % k == 0 || j + 1 == ext) ? v : (dilate ? max(v, h[j + 1]) : min(v, h[j + 1]));
+    }
+
+    // Prefix extrema, the window [x - r, x + r] spans at most the end of one block and the start of the next
+    uchar g = 0;
+    for (uint j = 0; j < ext; ++j)
+    {
+        uchar v = input[clamp((int)j - r, 0, (int)n - 1) * stride];
+        g = j % k == 0 ? v : (dilate ? max(g, v) : min(g, v));
+        if (j >= 2 * radius)
+        {
+            uint x = j - 2 * radius;
+            output[x * stride] = dilate ? max(h[x], g) : min(h[x], g);
+        }
+    }
+}
+
+// Summed-area tables of the .w channel and of its square, so box statistics cost the same for any radius.
+// One inclusive scan per line and axis, lines addressed like gaussianIIR. Axis 0 reads the input, the others
+// the previous pass's tables, so a pass run twice gives the same result. The sums wrap, but differences of
+// them stay exact while a box's own sum fits (uint for values, ulong for squares).
+kernel void integralLine(
+    uint depth, uint length, uint width, global uchar4 *input, global const uint *sumIn, global const ulong *squaresIn,
+    global uint *sum, global ulong *squares, uint axis)
+{
+    SPECIALISE(depth, length, width);
+
+    uint a = get_global_id(0);
+    uint b = get_global_id(1);
+
+    uint n, stride, start;
+    if (axis == 0)
+    {
+        n = depth;
+        stride = 1;
+        start = a * depth + b * depth * length;
+    }
+    else if (axis == 1)
+    {
+        n = length;
+        stride = depth;
+        start = a + b * depth * length;
+    }
+    else
+    {
+        n = width;
+        stride = depth * length;
+        start = a + (b % length) * depth + (b / length) * depth * length * width;
+    }
+    input += start;
+    sumIn += start;
+    squaresIn += start;
+    sum += start;
+    squares += start;
+
+    uint s = 0;
+    ulong q = 0;
+    for (uint i = 0; i < n; ++i)
+    {
+        if (axis == 0)
+        {
+            uint v = input[i * stride].w;
+            s += v;
+            q += v * v;
+        }
+        else
+        {
+            s += sumIn[i * stride];
+            q += squaresIn[i * stride];
+        }
+        sum[i * stride] = s;
+        squares[i * stride] = q;
+    }
+}
+
+// Mean (statistic 0), variance over 64 (1) or adaptive threshold (2) of the box of radius per axis, clipped to
+// the volume. The threshold keeps voxels above the local mean plus bias and clears the rest like threshold.
+kernel void boxStatistics(
+    uint depth, uint length, uint width, global uchar4 *input, global uint *sum, global ulong *squares,
+    global uchar4 *output, uint4 radius, uint statistic, float bias)
+{
+    SPECIALISE(depth, length, width);
+
+    uint x = get_global_id(0);
+    uint y = get_global_id(1);
+    uint z = get_global_id(2);
+
+    uint frame = (z / width) * depth * length * width;
+    int3 p = (int3)(x, y, z % width);
+    int3 lo = max(p - convert_int3(radius.xyz), (int3)(0)) - 1;
+    int3 hi = min(p + convert_int3(radius.xyz), (int3)(depth - 1, length - 1, width - 1));
+
+    // Inclusion-exclusion over the corners, those below the volume's lower edge add nothing.
+    uint s = 0;
+    ulong q = 0;
+    for (int c = 0; c < 8; ++c)
+    {
+        int3 k = (int3)(c & 1 ? lo.x : hi.x, c & 2 ? lo.y : hi.y, c & 4 ? lo.z : hi.z);
+        if (k.x < 0 || k.y < 0 || k.z < 0)
+            continue;
+
+        uint i = frame + k.x + k.y * depth + k.z * depth * length;
+        if (popcount(c) & 1)
+        {
+            s -= sum[i];
+            q -= squares[i];
+        }
+        else
+        {
+            s += sum[i];
+            q += squares[i];
+        }
+    }
+
+    ulong n = (ulong)((hi.x - lo.x) * (hi.y - lo.y) * (hi.z - lo.z));
+    float mean = convert_float(s) / convert_float(n);
+
+    uint offset = x + y * depth + z * length * depth;
+    output[offset] = input[offset];
+    if (statistic == 0)
+    {
+        output[offset].w = convert_uchar_sat_rte(mean);
+    }
+    else if (statistic == 1)
+    {
+        // n * q - s * s is exact, the float only divides it
+        output[offset].w = convert_uchar_sat_rte(convert_float(n * q - (ulong)s * s) / convert_float(n * n) / 64.0f);
+    }
+    else if (convert_float(input[offset].w) <= mean + bias)
+    {
+        output[offset] = (uchar4)(0x00, 0x00, 0x00, 0x00);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "FrameCache.hh"
+
+#include <algorithm>
+#include <iostream>
+
+namespace data
+{
+
+    std::size_t FrameCache::deviceBudget = 256u << 20;
+    std::size_t FrameCache::hostBudget = 1024u << 20;
+    cl::CommandQueue FrameCache::queue;
+    std::list<FrameCache::Entry> FrameCache::entries;
+    std::size_t FrameCache::deviceBytes = 0;
+    std::size_t FrameCache::hostBytes = 0;
+
+    void FrameCache::store(const key_t &key, const Volume &v, const cl::CommandQueue &producer)
+    {
+        // Option edits only go up, frames from older parameters of this node can't be asked for again.
+        erase([&key](const Entry &e)
+              { return std::get<0>(e.key) == std::get<0>(key) && std::get<4>(e.key) != std::get<4>(key); });
+
+        Entry entry{key, v, cl::Context(), producer, 0};
+        entry.frame.image = cl::Image3D();
+
+        if (v.buffer() != nullptr)
+        {
+            entry.frame.raw.clear();
+            entry.context = v.buffer.getInfo<CL_MEM_CONTEXT>();
+            entry.bytes = v.buffer.getInfo<CL_MEM_SIZE>();
+            deviceBytes += entry.bytes;
+        }
+        else
+        {
+            entry.bytes = v.raw.empty() ? 0 : v.raw[0].size() * sizeof(cl_uchar4);
+            hostBytes += entry.bytes;
+        }
+
+        entries.push_front(std::move(entry));
+        evict();
+    }
+
+    bool FrameCache::fetch(const key_t &key, Volume &v)
+    {
+        auto itr = std::find_if(entries.begin(), entries.end(), [&key](const Entry &e)
+                                { return e.key == key; });
+        if (itr == entries.end())
+            return false;
+
+        entries.splice(entries.begin(), entries, itr);
+        Entry &entry = entries.front();
+
+        // Spilled, back on the device it came from.
+        if (entry.frame.buffer() == nullptr && entry.context() != nullptr)
+        {
+            try
+            {
+                entry.frame.buffer = cl::Buffer(entry.context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, entry.bytes, entry.frame.raw[0].data());
+            }
+            catch (const cl::Error &e)
+            {
+                std::cerr << "FrameCache, " << e.what() << " : " << e.err() << '\n';
+                return false;
+            }
+            entry.frame.raw.clear();
+            hostBytes -= entry.bytes;
+            deviceBytes += entry.bytes;
+        }
+
+        v.mirror(entry.frame);
+        v.version = entry.frame.version;
+        v.buffer = entry.frame.buffer;
+        v.image = cl::Image3D();
+        v.raw = entry.frame.raw;
+
+        evict();
+        return true;
+    }
+
+    void FrameCache::drop(const void *node)
+    {
+        erase([node](const Entry &e)
+              { return std::get<0>(e.key) == node; });
+    }
+
+    bool FrameCache::shed()
+    {
+        auto last = std::find_if(entries.rbegin(), entries.rend(), [](const Entry &e)
+                                 { return e.frame.buffer() != nullptr; });
+        if (last == entries.rend())
+            return false;
+
+        spill(std::next(last).base());
+        evict();
+        return true;
+    }
+
+    void FrameCache::erase(const std::function<bool(const Entry &)> &match)
+    {
+        for (auto itr = entries.begin(); itr != entries.end();)
+        {
+            if (!match(*itr))
+            {
+                ++itr;
+                continue;
+            }
+            (itr->frame.buffer() != nullptr ? deviceBytes : hostBytes) -= itr->bytes;
+            itr = entries.erase(itr);
+        }
+    }
+
+    void FrameCache::evict()
+    {
+        // Device frames past the budget spill, oldest first, the most recent one always stays.
+        auto itr = entries.end();
+        while (deviceBytes > deviceBudget && entries.size() > 1 && itr != std::next(entries.begin()))
+        {
+            --itr;
+            if (itr->frame.buffer() != nullptr)
+                itr = spill(itr);
+        }
+
+        while (hostBytes > hostBudget && entries.size() > 1)
+        {
+            auto last = std::find_if(entries.rbegin(), entries.rend(), [](const Entry &e)
+                                     { return e.frame.buffer() == nullptr; });
+            if (last == entries.rend())
+                break;
+
+            hostBytes -= last->bytes;
+            entries.erase(std::next(last).base());
+        }
+    }
+
+    // Reads a device frame back to the host, a frame that fails to is dropped instead.
+    std::list<FrameCache::Entry>::iterator FrameCache::spill(std::list<Entry>::iterator itr)
+    {
+        deviceBytes -= itr->bytes;
+        try
+        {
+            itr->frame.raw = {itr->frame.loadFromCl(itr->producer() != nullptr ? itr->producer : queue)};
+            itr->frame.buffer = cl::Buffer();
+            hostBytes += itr->bytes;
+            return itr;
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "FrameCache, " << e.what() << " : " << e.err() << '\n';
+            return entries.erase(itr);
+        }
+    }
+
+} // namespace data
\ No newline at end of file
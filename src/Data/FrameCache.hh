@@ -0,0 +1,58 @@
+#ifndef DATA_FRAMECACHE_HH
+#define DATA_FRAMECACHE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <tuple>
+#include <vector>
+
+#include <CL/cl2.hpp>
+
+#include "Volume.hh"
+
+namespace data
+{
+
+    // Processed frames of the nodes that opt in (gui::Kernel), so revisiting a frame skips the chain. Entries
+    // keep the node's output buffer itself, filters allocate a new one every input so it is never written
+    // again. Past the device budget the least recently used frames are read back to host memory, past the
+    // host budget they are dropped.
+    class FrameCache
+    {
+    public:
+        // Node, its input volume, the input's version, frame and option edits.
+        using key_t = std::tuple<const void *, const Volume *, std::uint64_t, cl_uint, std::uint64_t>;
+
+        static std::size_t deviceBudget;
+        static std::size_t hostBudget;
+        static cl::CommandQueue queue; // Spill readbacks of frames stored without their producer's queue
+
+        static void store(const key_t &key, const Volume &v, const cl::CommandQueue &producer = cl::CommandQueue());
+        static bool fetch(const key_t &key, Volume &v);
+        static void drop(const void *node);
+        static bool shed(); // Spills the least recently used device frame for opencl::Arena, false when none is left
+
+    private:
+        struct Entry
+        {
+            key_t key;
+            Volume frame;              // Header and version, buffer while on the device, raw once spilled or from a host filter
+            cl::Context context;       // Where a spilled frame goes back to, null for host filters
+            cl::CommandQueue producer; // The frame was computed on, spills read it back there behind the kernels
+            std::size_t bytes;
+        };
+
+        static std::list<Entry> entries; // Most recently used first
+        static std::size_t deviceBytes;
+        static std::size_t hostBytes;
+
+        static void erase(const std::function<bool(const Entry &)> &match);
+        static void evict();
+        static std::list<Entry>::iterator spill(std::list<Entry>::iterator itr);
+    };
+
+} // namespace data
+
+#endif
\ No newline at end of file
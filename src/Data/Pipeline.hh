@@ -0,0 +1,143 @@
+#ifndef DATA_PIPELINE_HH
+#define DATA_PIPELINE_HH
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace data
+{
+
+    // Bounded single-producer single-consumer ring, lock-free. Blocks (yielding) when full or empty.
+    template <typename T, std::size_t N = 4>
+    class RingQueue
+    {
+        static_assert((N & (N - 1)) == 0, "RingQueue capacity must be a power of two.");
+
+    private:
+        std::array<std::optional<T>, N> ring;
+        alignas(64) std::atomic<std::size_t> head = 0;
+        alignas(64) std::atomic<std::size_t> tail = 0;
+
+    public:
+        void push(T &&t)
+        {
+            std::size_t h = head.load(std::memory_order_relaxed);
+            while (h - tail.load(std::memory_order_acquire) == N)
+            {
+                std::this_thread::yield();
+            }
+            ring[h & (N - 1)] = std::move(t);
+            head.store(h + 1, std::memory_order_release);
+        }
+
+        T pop()
+        {
+            std::size_t t = tail.load(std::memory_order_relaxed);
+            while (head.load(std::memory_order_acquire) == t)
+            {
+                std::this_thread::yield();
+            }
+            T v = std::move(*ring[t & (N - 1)]);
+            ring[t & (N - 1)].reset();
+            tail.store(t + 1, std::memory_order_release);
+            return v;
+        }
+    };
+
+    // Staged pipeline, every stage runs on its own thread on a different item, connected by RingQueues.
+    // With pipelined = false the stages run one after another on the calling thread (the old serial path).
+    // A stage that throws stops the run: the remaining items drain through without running any stage and
+    // run() rethrows the first exception on the calling thread.
+    template <typename T, std::size_t N = 4>
+    class Pipeline
+    {
+    public:
+        using source_t = std::function<T(unsigned int)>;
+        using stage_t = std::function<void(T &)>;
+
+    private:
+        std::vector<stage_t> stages;
+
+    public:
+        bool pipelined = true;
+
+        Pipeline &addStage(stage_t &&s)
+        {
+            stages.push_back(std::move(s));
+            return *this;
+        }
+
+        void run(unsigned int count, const source_t &source)
+        {
+            if (!pipelined || stages.empty())
+            {
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                    T t = source(i);
+                    for (auto &s : stages)
+                    {
+                        s(t);
+                    }
+                }
+                return;
+            }
+
+            std::vector<RingQueue<T, N>> queues(stages.size());
+            std::vector<std::thread> threads;
+            threads.reserve(stages.size());
+
+            std::atomic<bool> failed = false;
+            std::exception_ptr error;
+            std::atomic_flag first = ATOMIC_FLAG_INIT;
+
+            for (std::size_t s = 0; s < stages.size(); ++s)
+            {
+                threads.emplace_back(
+                    [&, s]()
+                    {
+                        for (unsigned int i = 0; i < count; ++i)
+                        {
+                            T t = queues[s].pop();
+                            if (!failed.load(std::memory_order_acquire))
+                            {
+                                try
+                                {
+                                    stages[s](t);
+                                }
+                                catch (...)
+                                {
+                                    if (!first.test_and_set())
+                                        error = std::current_exception();
+                                    failed.store(true, std::memory_order_release);
+                                }
+                            }
+                            if (s + 1 < stages.size())
+                                queues[s + 1].push(std::move(t));
+                        }
+                    });
+            }
+
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                queues[0].push(source(i));
+            }
+
+            for (auto &t : threads)
+            {
+                t.join();
+            }
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+    };
+
+} // namespace data
+
+#endif
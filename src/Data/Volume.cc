@@ -1,72 +1,161 @@
-#include "Volume.hh"
-
-#include <numbers>
-
-#include <gl/glew.h>
-#include <gl/gl.h>
-#include <gl/glext.h>
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "../Events/GUI.hh"
-
-namespace data
-{
-
-    Volume::Volume(unsigned int d, unsigned int l, unsigned int w, unsigned int f, const std::vector<uint8_t> &data) : Volume()
-    {
-        depth = d;
-        length = l;
-        width = w;
-        frames = f;
-
-        raw.resize(frames);
-
-        for (unsigned int v = 0; v < frames; ++v)
-        {
-            auto zyxv = v * length * depth * width;
-            for (unsigned int z = 0; z < width; ++z)
-            {
-                auto zyx = z * length * depth;
-                for (unsigned int y = 0; y < length; ++y)
-                {
-                    auto yx = y * depth;
-                    for (unsigned int x = 0; x < depth; ++x)
-                    {
-                        cl_uchar bnw = data.at(x + yx + zyx + zyxv);
-                        cl_uchar4 arr = {bnw, bnw, bnw, 0xFF};
-                        raw[v].push_back(arr);
-                    }
-                }
-            }
-        }
-    }
-
-    Volume::Volume() : cFrame(0), rFrame(0)
-    {
-    }
-
-    Volume::~Volume()
-    {
-    }
-
-    std::vector<cl_uchar4> Volume::loadFromCl(const cl::CommandQueue &cQueue)
-    {
-        auto bSize = buffer.getInfo<CL_MEM_SIZE>();
-        std::vector<cl_uchar4> bVec(bSize);
-        cQueue.enqueueReadBuffer(buffer, CL_TRUE, 0, bSize, bVec.data()); // Rework into non-blocking
-        cQueue.finish();
-        return bVec;
-    }
-
-    void Volume::sendToCl(const cl::Context &context, unsigned int i)
-    {
-        buffer = cl::Buffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, sizeof(raw[i][0]) * raw[i].size(), raw[i].data());
-    }
-
-    void Volume::update()
-    {
-    }
-
+#include "Volume.hh"
+
+#include <cstddef>
+#include <numbers>
+
+#include <gl/glew.h>
+#include <gl/gl.h>
+#include <gl/glext.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "../Events/GUI.hh"
+
+namespace data
+{
+
+    bool Volume::useImages = true;
+
+    Volume::Volume(unsigned int d, unsigned int l, unsigned int w, unsigned int f, const std::vector<uint8_t> &data) : Volume()
+    {
+        depth = d;
+        length = l;
+        width = w;
+        frames = f;
+
+        raw.resize(frames);
+
+        for (unsigned int v = 0; v < frames; ++v)
+        {
+            auto zyxv = v * length * depth * width;
+            for (unsigned int z = 0; z < width; ++z)
+            {
+                auto zyx = z * length * depth;
+                for (unsigned int y = 0; y < length; ++y)
+                {
+                    auto yx = y * depth;
+                    for (unsigned int x = 0; x < depth; ++x)
+                    {
+                        cl_uchar bnw = data.at(x + yx + zyx + zyxv);
+                        cl_uchar4 arr = {bnw, bnw, bnw, 0xFF};
+                        raw[v].push_back(arr);
+                    }
+                }
+            }
+        }
+    }
+
+    Volume::Volume() : cFrame(0), rFrame(0)
+    {
+    }
+
+    Volume::~Volume()
+    {
+    }
+
+    void Volume::mirror(const Volume &v)
+    {
+        // Everything but the frame data.
+        min = v.min;
+        max = v.max;
+        depth = v.depth;
+        length = v.length;
+        width = v.width;
+        frames = v.frames;
+        cFrame = v.cFrame;
+        rFrame = v.rFrame;
+        batch = v.batch;
+        ratio = v.ratio;
+        delta = v.delta;
+        fRate = v.fRate;
+        pointRange = v.pointRange;
+        lineRange = v.lineRange;
+    }
+
+    std::vector<cl_uchar4> Volume::loadFromCl(const cl::CommandQueue &cQueue)
+    {
+        auto bSize = buffer.getInfo<CL_MEM_SIZE>();
+        std::vector<cl_uchar4> bVec(bSize / sizeof(cl_uchar4));
+        cQueue.enqueueReadBuffer(buffer, CL_TRUE, 0, bSize, bVec.data()); // Rework into non-blocking
+        cQueue.finish();
+        return bVec;
+    }
+
+    void Volume::sendToCl(const cl::Context &context, unsigned int i)
+    {
+        // No context on the native backend, the frames stay in raw.
+        if (context() == nullptr)
+            return;
+
+        buffer = cl::Buffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, sizeof(raw[i][0]) * raw[i].size(), raw[i].data());
+    }
+
+    // Current frame on the host, a filter's output holds only that one, a reader's holds every frame.
+    const std::vector<cl_uchar4> &Volume::host() const
+    {
+        return raw.size() == 1 ? raw[0] : raw.at(rFrame);
+    }
+
+    // Copies buffer into image unless it already holds this version of it, false when the device can't hold it as one and callers should stay on the buffer.
+    bool Volume::toImage(const cl::Context &context, cl::CommandQueue &cQueue)
+    {
+        if (!useImages || buffer() == nullptr)
+            return false;
+
+        // Same buffer and version, the image already holds it. A version of 0 is unknown (exports, fresh
+        // volumes) and always copied.
+        std::tuple<cl_context, cl_mem, std::uint64_t> from = {context(), buffer(), version};
+        if (version != 0 && image() != nullptr && imaged == from)
+        {
+            // Graph branches share the volume and the copy may be on another queue, order this one behind it.
+            try
+            {
+                std::vector<cl::Event> wait = {copied};
+                cQueue.enqueueBarrierWithWaitList(&wait);
+            }
+            catch (const cl::Error &e)
+            {
+                return false;
+            }
+            return true;
+        }
+
+        std::size_t z = static_cast<std::size_t>(width) * batch;
+
+        try
+        {
+            cl::Device device = cQueue.getInfo<CL_QUEUE_DEVICE>();
+            if (!device.getInfo<CL_DEVICE_IMAGE_SUPPORT>() || depth > device.getInfo<CL_DEVICE_IMAGE3D_MAX_WIDTH>() || length > device.getInfo<CL_DEVICE_IMAGE3D_MAX_HEIGHT>() || z > device.getInfo<CL_DEVICE_IMAGE3D_MAX_DEPTH>())
+            {
+                image = cl::Image3D();
+                imaged = {};
+                return false;
+            }
+
+            // Kept while the shape holds, node volumes get a new buffer every frame.
+            if (image() == nullptr || image.getInfo<CL_MEM_CONTEXT>()() != context() || image.getImageInfo<CL_IMAGE_WIDTH>() != depth || image.getImageInfo<CL_IMAGE_HEIGHT>() != length || image.getImageInfo<CL_IMAGE_DEPTH>() != z)
+            {
+                image = cl::Image3D(context, CL_MEM_READ_ONLY, cl::ImageFormat(CL_RGBA, CL_UNORM_INT8), depth, length, z);
+            }
+
+            cQueue.enqueueCopyBufferToImage(buffer, image, 0, {0, 0, 0}, {depth, length, z}, nullptr, &copied);
+            cQueue.flush(); // Submitted, so another queue waiting on it cannot stall
+            imaged = from;
+        }
+        catch (const cl::Error &e)
+        {
+            // Format or size the device turns down, stay on the buffer.
+            image = cl::Image3D();
+            imaged = {};
+            return false;
+        }
+
+        return true;
+    }
+
+    void Volume::update()
+    {
+    }
+
 } // namespace data
\ No newline at end of file
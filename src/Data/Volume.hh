@@ -1,51 +1,67 @@
-#ifndef DATA_VOLUME_HH
-#define DATA_VOLUME_HH
-
-#include <array>
-#include <utility>
-#include <vector>
-
-#include <glm/glm.hpp>
-
-#include <CL/cl2.hpp>
-#include <SDL2/SDL.h>
-
-#include "../events/EventManager.hh"
-
-namespace data
-{
-
-    class Volume
-    {
-    public:
-        Volume();
-        std::vector<std::vector<cl_uchar4>> raw;
-
-
-        cl_uchar max = 0;
-        cl_uchar min = 0xFF;
-
-        cl_uint depth;
-        cl_uint length;
-        cl_uint width;
-        cl_uint frames;
-        cl_uint cFrame;
-        cl_uint rFrame;
-
-        cl::Buffer buffer;
-        cl_float ratio;
-        cl_float delta;
-        cl_float fRate;
-
-        Volume(const Volume &) = default;
-        Volume(Volume &&) = default;
-        Volume(unsigned int depth, unsigned int length, int unsigned width, unsigned int frames, const std::vector<uint8_t> &data);
-        ~Volume();
-
-        std::vector<cl_uchar4> loadFromCl(const cl::CommandQueue &cQueue);
-        void sendToCl(const cl::Context &context, unsigned int i);
-        void update();
-    };
-
-}
+#ifndef DATA_VOLUME_HH
+#define DATA_VOLUME_HH
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <CL/cl2.hpp>
+#include <SDL2/SDL.h>
+
+#include "../events/EventManager.hh"
+
+namespace data
+{
+
+    class Volume
+    {
+    public:
+        static bool useImages; // false (--no-images) keeps every kernel on the buffer path
+
+        Volume();
+        std::vector<std::vector<cl_uchar4>> raw;
+
+
+        cl_uchar max = 0;
+        cl_uchar min = 0xFF;
+
+        cl_uint depth;
+        cl_uint length;
+        cl_uint width;
+        cl_uint frames;
+        cl_uint cFrame;
+        cl_uint rFrame;
+        cl_uint batch = 1; // Frames packed back to back in buffer, starting at rFrame.
+        std::uint64_t version = 0; // Bumped by the node owning this volume each time it recomputes it, not mirrored.
+
+        cl::Buffer buffer;
+        cl::Image3D image; // buffer as CL_RGBA/CL_UNORM_INT8 for filtered reads, the batch stacked along z, see toImage
+        cl_float ratio;
+        cl_float delta;
+        cl_float fRate;
+        std::array<cl_float, 2> pointRange = {0.0f, 0.0f}; // Beam distance of the first and last sample, 0s when not a fan
+        std::array<cl_float, 2> lineRange = {0.0f, 0.0f};  // Beam angle of the first and last line, 0s when not a fan
+
+        Volume(const Volume &) = default;
+        Volume(Volume &&) = default;
+        Volume(unsigned int depth, unsigned int length, int unsigned width, unsigned int frames, const std::vector<uint8_t> &data);
+        ~Volume();
+
+        void mirror(const Volume &v);
+        std::vector<cl_uchar4> loadFromCl(const cl::CommandQueue &cQueue);
+        void sendToCl(const cl::Context &context, unsigned int i);
+        const std::vector<cl_uchar4> &host() const;
+        bool toImage(const cl::Context &context, cl::CommandQueue &cQueue);
+        void update();
+
+    private:
+        std::tuple<cl_context, cl_mem, std::uint64_t> imaged = {nullptr, nullptr, 0}; // What image was last copied from
+        cl::Event copied; // That copy, readers on other queues wait on it
+    };
+
+}
 #endif
\ No newline at end of file
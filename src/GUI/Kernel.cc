@@ -1,330 +1,921 @@
-#include "Kernel.hh"
-#include "Dropzone.hh"
-#include "Renderer.hh"
-
-namespace gui
-{
-
-    std::vector<std::weak_ptr<Kernel>> Kernel::xKernels;
-
-    void Kernel::executeKernels(cl_uint i)
-    {
-        for (auto &wptr : xKernels)
-        {
-            auto sptr = wptr.lock();
-            sptr->volume->rFrame = i;
-            sptr->execute(sptr->volume, sptr->modified);
-        }
-    }
-
-    void Kernel::updateLine(float ox, float oy)
-    {
-        float newX = x + w;
-        float newY = outNode->y + outNode->h / 2.0f - outLine.h / 2.0f;
-        outLine.angle = std::atan2(oy - newY, ox - newX);
-        outLine.update(
-            newX - outLine.x,
-            newY - outLine.y,
-            std::sqrt((oy - outLine.y) * (oy - outLine.y) + (ox - outLine.x) * (ox - outLine.x)) - outLine.w,
-            0.0f);
-    }
-
-    void Kernel::draw()
-    {
-        Rectangle::upload();
-        title.upload();
-        renderButton->draw();
-        inNode->draw();
-        outNode->draw();
-        options->draw();
-
-        if (!outLine.hidden)
-        {
-            outLine.upload();
-        }
-    }
-
-    std::shared_ptr<Kernel> Kernel::build(std::shared_ptr<opencl::Filter> &&f, std::shared_ptr<Texture> &&tptr)
-    {
-        auto sptr = std::shared_ptr<Kernel>(new Kernel(std::move(f), std::forward<std::shared_ptr<Texture>>(tptr)));
-        sptr->Rectangle::draw = std::bind(Kernel::draw, sptr.get());
-        sptr->Rectangle::resize = std::bind(update, sptr.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-
-        sptr->eventManager->addCallback(
-            SDL_MOUSEBUTTONDOWN,
-            [wptr = sptr->weak_from_this()](const SDL_Event &e)
-            {
-                auto ptr = wptr.lock();
-                if (events::containsMouse(std::as_const(*ptr->outNode), e))
-                {
-                    if (ptr->outLink)
-                    {
-                        ptr->outLink->inLink.reset();
-                    }
-
-                    ptr->updateLine(static_cast<float>(e.motion.x), static_cast<float>(e.motion.y));
-                    ptr->outLine.hidden = false;
-                    ptr->link = true;
-                    ptr->outNode->eventManager->process(e);
-                    return;
-                }
-                else if (events::containsMouse(std::as_const(*ptr->options), e))
-                {
-                    ptr->h = ptr->h - ptr->options->h;
-                    ptr->options->eventManager->process(e);
-                    ptr->optionEvent = ptr->options->subManager;
-                    ptr->h = ptr->h + ptr->options->h;
-                    ptr->Rectangle::update();
-                }
-                else
-                {
-                    ptr->link = false;
-                    ptr->move = true;
-                }
-            });
-
-        sptr->eventManager->addCallback(
-            SDL_DROPFILE,
-            [wptr = sptr->weak_from_this()](const SDL_Event &e)
-            {
-                auto ptr = wptr.lock();
-                ptr->filter->volume = ptr->volume;
-                if (!ptr->filter->load(e.drop.file))
-                {
-                    SDL_free(e.drop.file);
-                    return;
-                }
-                
-                SDL_free(e.drop.file);
-
-                for (auto itr = xKernels.begin(); itr != xKernels.end(); ++itr)
-                {
-                    if (itr->lock() == ptr)
-                    {
-                        xKernels.erase(itr);
-                        break;
-                    }
-                }
-
-                xKernels.push_back(wptr);
-
-                ptr->modified = true;
-
-                executeKernels(0);
-            });
-
-        sptr->eventManager->addCallback(
-            SDL_MOUSEBUTTONUP,
-            [wptr = sptr->weak_from_this()](const SDL_Event &e)
-            {
-                auto ptr = wptr.lock();
-                ptr->move = false;
-                if (!ptr)
-                    return;
-
-                auto optr = ptr->optionEvent.lock();
-                if (optr)
-                {
-                    optr->process(e);
-                    ptr->optionEvent.reset();
-                }
-                else if (events::containsMouse(std::as_const(*ptr->renderButton), e))
-                {
-                    ptr->renderButton->eventManager->process(e);
-                    return;
-                }
-            });
-
-        sptr->eventManager->addCallback(
-            SDL_MOUSEMOTION,
-            [wptr = sptr->weak_from_this()](const SDL_Event &e)
-            {
-                auto ptr = wptr.lock();
-                auto optr = ptr->optionEvent.lock();
-
-                if (ptr->link)
-                {
-                    ptr->updateLine(static_cast<float>(e.motion.x), static_cast<float>(e.motion.y));
-                }
-                else if (optr)
-                {
-                    optr->process(e);
-                }
-                else if (ptr->move)
-                {
-                    ptr->resize(static_cast<float>(e.motion.xrel), static_cast<float>(e.motion.yrel), 0.0f, 0.0f);
-                }
-            });
-        return sptr;
-    }
-
-    bool Kernel::endLink(const SDL_Event &e, std::shared_ptr<Kernel> &k)
-    {
-        if (k.get() == this)
-        {
-            link = false;
-            outLine.hidden = true;
-            outLink.reset();
-            fire = []([[maybe_unused]] auto &a, [[maybe_unused]] bool b) {};
-            return false;
-        }
-
-        if (events::containsMouse(*k, e))
-        {
-            if (k->inLink)
-            {
-                k->inLink->outLink.reset();
-                k->inLink->outLine.hidden = true;
-            }
-
-            updateLine(k->inNode->x, k->inNode->y + k->inNode->h / 2.0f);
-
-            outLink = k;
-            k->inLink = shared_from_this();
-
-            fire = std::bind(Kernel::execute, k.get(), std::placeholders::_1, std::placeholders::_2);
-
-            outLine.hidden = false;
-
-            // k->active = ptr->active;
-
-            // When executing will allow a save to occur
-            k->modified = true;
-
-            return true;
-        }
-        else
-        {
-            link = false;
-            outLine.hidden = true;
-            outLink.reset();
-            fire = []([[maybe_unused]] auto &a, [[maybe_unused]] bool b) {};
-        }
-        return false;
-    }
-
-    Kernel::Kernel(std::shared_ptr<opencl::Filter> &&f, std::shared_ptr<Texture> &&tptr) : Rectangle(0.0f, 0.0f, 40.0f, 40.0f), filter(std::forward<std::shared_ptr<opencl::Filter>>(f)), outLine({0.0f, 0.0f, 0.0f, 3.0f}), title(0.0f, 0.0f, static_cast<float>(tptr->textureW), static_cast<float>(tptr->textureH), std::forward<std::shared_ptr<Texture>>(tptr))
-    {
-        texture->fill({0x5C, 0x5C, 0x5C, 0xFF});
-
-        inNode = (Button::build("IN"));
-        outNode = (Button::build("-->"));
-        renderButton = (Button::build("+"));
-
-        w = std::max(w, title.w + renderButton->w + 2.0f);
-        h = title.h * 3.0f;
-
-        options = filter->getOptions();
-
-        if (options->empty())
-        {
-            options->hidden = true;
-        }
-        else
-        {
-            w = std::max(w, options->w);
-        }
-
-        int mx, my;
-        SDL_GetMouseState(&mx, &my);
-
-        x = static_cast<float>(mx) - w / 2.0f;
-        y = static_cast<float>(my) - h / 2.0f;
-        
-        if (!options->empty())
-        {
-            options->resize(x - options->x, y + h - options->y, 0.0f, 0.0f);
-            h = h + options->h;
-            
-            inNode->resize(
-                x + 2.0f - inNode->x,
-                y + (h - options->h) / 2.0f - inNode->y, 0.0f, 0.0f);
-            outNode->resize(
-                x + w - 2.0f - outNode->w - outNode->x,
-                y + (h - options->h) / 2.0f - outNode->y, 0.0f, 0.0f);
-        }
-        else
-        {
-            inNode->resize(
-                x + 2.0f - inNode->x,
-                y + h / 2.0f - inNode->y, 0.0f, 0.0f);
-            outNode->resize(
-                x + w - 2.0f - outNode->w - outNode->x,
-                y + h / 2.0f - outNode->y, 0.0f, 0.0f);
-        }
-
-        title.update(x + w / 2.0f - title.w / 2.0f - renderButton->w / 2.0f - 1.0f - title.x,
-                     y - title.y);
-        renderButton->resize(
-            title.x + title.w + 2.0f - renderButton->x,
-            title.y - renderButton->y, 0.0f, 0.0f);
-
-        outLine.hidden = true;
-        outLine.texture->fill({0xD3, 0xD3, 0xD3, 0xFF});
-
-        Rectangle::update();
-
-        arm = std::bind(filter->input, std::placeholders::_1);
-    }
-
-    void Kernel::execute(std::shared_ptr<data::Volume> &sp, bool m)
-    {
-        active = true;
-        if (m == true)
-            modified = m;
-
-        filter->volume = volume;
-
-        if (sp)
-            arm(sp);
-
-        filter->toggle = modified;
-        filter->execute();
-
-        if (outLink)
-            fire(volume, modified);
-
-        modified = false;
-    }
-
-    void Kernel::update(float dx, float dy, float dw, float dh)
-    {
-        Rectangle::update(dx, dy, dw, dh);
-        inNode->resize(dx, dy, dw, dh);
-        outNode->resize(dx, dy, dw, dh);
-        // outLine.update(dx, dy, dw, dh);
-        title.update(dx, dy, dw, dh);
-        renderButton->resize(dx, dy, dw, dh);
-        options->resize(dx, dy, dw, dh);
-
-        if (outLink)
-            updateLine(outLink->inNode->x, outLink->inNode->y + outLink->inNode->h / 2.0f);
-
-        if (inLink)
-            inLink->updateLine(inNode->x + inNode->w, inNode->y + inNode->h / 2.0f);
-    }
-
-    std::shared_ptr<Renderer> Kernel::buildRenderer(std::vector<std::shared_ptr<Renderer>> &wr)
-    {
-
-        if (active)
-        {
-            try
-            {
-                volume->buffer.template getInfo<CL_MEM_SIZE>();
-                return Renderer::build(wr, {0.0f, 0.0f, 1.0f, 1.0f, std::make_shared<gui::Texture>(512, 512)}, std::shared_ptr(filter->volume), shared_from_this());
-            }
-            catch (const cl::Error &e)
-            {
-                SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Render Error", "This kernel does not store a valid volume.", nullptr);
-            }
-        }
-        else
-        {
-            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "Render Information", "This kernel is currently inactive. Ultrasound data must be processed by this kernel before it can be displayed.", nullptr);
-        }
-
-        return std::shared_ptr<Renderer>(nullptr);
-    }
-
+#include "Kernel.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "Dropzone.hh"
+#include "Renderer.hh"
+
+#include "../Data/FrameCache.hh"
+#include "../Data/Pipeline.hh"
+#include "../OpenCL/Arena.hh"
+#include "../OpenCL/DeviceGroup.hh"
+
+namespace gui
+{
+
+    std::vector<std::weak_ptr<Kernel>> Kernel::xKernels;
+    std::uint64_t Kernel::generations = 0;
+
+    // Filter nodes under a loader that lead to a writer, each after the node feeding it, and the writers with
+    // theirs. A node feeding several branches is run once per frame for all of them.
+    struct Kernel::Graph
+    {
+        static constexpr std::size_t fromSource = static_cast<std::size_t>(-1);
+
+        std::vector<std::pair<std::shared_ptr<Kernel>, std::size_t>> nodes;
+        std::vector<std::pair<std::shared_ptr<Kernel>, std::size_t>> writers;
+
+        explicit Graph(const Kernel &head)
+        {
+            for (auto &k : head.outLinks)
+                walk(k, fromSource);
+
+            // Exports overwrite the node volumes without restamping them, version 0 keeps Volume::toImage copying.
+            // They enqueue on the device's queue alone, whatever branch a node was last run on.
+            for (auto &node : nodes)
+            {
+                node.first->volume->version = 0;
+                node.first->filter->queue = node.first->home;
+            }
+            for (auto &writer : writers)
+                writer.first->filter->queue = writer.first->home;
+        }
+
+        bool walk(const std::shared_ptr<Kernel> &k, std::size_t parent)
+        {
+            if (!k->filter->replicate)
+            {
+                writers.emplace_back(k, parent);
+                return true;
+            }
+
+            std::size_t at = nodes.size();
+            nodes.emplace_back(k, parent);
+
+            bool used = false;
+            for (auto &next : k->outLinks)
+                used = walk(next, at) || used;
+
+            // Branches no writer reads are left out of exports.
+            if (!used)
+                nodes.resize(at);
+            return used;
+        }
+
+        std::shared_ptr<data::Volume> &input(std::size_t parent, std::shared_ptr<data::Volume> &source)
+        {
+            return parent == fromSource ? source : nodes[parent].first->volume;
+        }
+
+        // The nodes' volumes hold the last exported batch now, not what the view last computed, and the
+        // writers' stamps point at freed frames.
+        void reset()
+        {
+            for (auto &node : nodes)
+                node.first->last.reset();
+            for (auto &writer : writers)
+                writer.first->last.reset();
+        }
+    };
+
+    void Kernel::executeKernels(cl_uint i)
+    {
+        for (auto &wptr : xKernels)
+        {
+            auto sptr = wptr.lock();
+            sptr->volume->rFrame = i;
+            sptr->execute(sptr->volume, sptr->modified);
+        }
+    }
+
+    void Kernel::exportKernels(opencl::Device &device, bool pipelined, cl_uint batch, std::size_t slab)
+    {
+        struct Item
+        {
+            cl_uint frame;
+            cl_uint count;
+            std::shared_ptr<data::Volume> volume;
+            cl::Event event;
+            std::vector<std::shared_ptr<data::Volume>> results; // One per writer
+        };
+
+        for (auto &wptr : xKernels)
+        {
+            auto head = wptr.lock();
+            if (!head)
+                continue;
+
+            Graph graph(*head);
+            if (graph.writers.empty())
+                continue;
+
+            std::shared_ptr<data::Volume> source = head->volume;
+
+            // Host filters run a frame at a time, each one already spread over the native pool.
+            if (device.native)
+            {
+                auto start = std::chrono::steady_clock::now();
+
+                try
+                {
+                    for (cl_uint f = 0; f < source->frames; ++f)
+                    {
+                        auto frame = std::make_shared<data::Volume>();
+                        frame->mirror(*source);
+                        frame->rFrame = f;
+                        frame->raw.push_back(source->raw[f]);
+
+                        for (auto &[k, parent] : graph.nodes)
+                        {
+                            k->filter->volume = k->volume;
+                            k->filter->input(graph.input(parent, frame));
+                            k->filter->execute();
+                        }
+
+                        for (auto &[tail, parent] : graph.writers)
+                        {
+                            auto &in = graph.input(parent, frame);
+                            auto out = std::make_shared<data::Volume>();
+                            out->mirror(*in);
+                            out->raw = in->raw;
+                            tail->execute(out, true);
+                        }
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "Export, " << e.what() << ", native export abandoned." << std::endl;
+                    graph.reset();
+                    continue;
+                }
+
+                graph.reset();
+
+                auto stop = std::chrono::steady_clock::now();
+                float ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(stop - start).count();
+                std::cout << "Export Time: " << ms << "ms, " << static_cast<float>(source->frames) * 1000.0f / ms << " fps (native)" << std::endl;
+                continue;
+            }
+
+            // A frame whose chain does not fit on the device goes through in z-slabs, each with the planes its
+            // chain reads beyond it, and the cores are stitched back on the host. Every node's output and scratch
+            // is live at once next to the input slab, all of it from the arena.
+            std::size_t planeVoxels = static_cast<std::size_t>(source->depth) * source->length;
+            std::size_t plane = sizeof(cl_uchar4) * planeVoxels;
+            std::size_t perVoxel = sizeof(cl_uchar4);
+            for (auto &node : graph.nodes)
+                perVoxel += node.first->filter->footprint ? node.first->filter->footprint() : sizeof(cl_uchar4);
+
+            std::size_t limit = std::min(slab ? slab : static_cast<std::size_t>(device.maxAlloc), opencl::Arena::budget);
+            if (limit && planeVoxels * source->width * perVoxel > limit)
+            {
+                // Halos add up along a branch, the sum over every node covers them all.
+                if (!std::all_of(graph.nodes.begin(), graph.nodes.end(), [](const auto &node)
+                                 { return static_cast<bool>(node.first->filter->halo); }))
+                {
+                    std::cerr << "Export, frames do not fit on the device and a filter needs the whole volume." << std::endl;
+                    continue;
+                }
+
+                cl_uint halo = 0;
+                for (auto &node : graph.nodes)
+                    halo += node.first->filter->halo();
+
+                cl_uint fit = static_cast<cl_uint>(std::min<std::size_t>(limit / (planeVoxels * perVoxel), source->width));
+                if (fit <= 2 * halo)
+                {
+                    std::cerr << "Export, no slab of " << fit << " planes fits a halo of " << halo << " either side." << std::endl;
+                    continue;
+                }
+                cl_uint core = fit - 2 * halo;
+
+                auto start = std::chrono::steady_clock::now();
+
+                try
+                {
+                    for (cl_uint f = 0; f < source->frames; ++f)
+                    {
+                        std::vector<std::shared_ptr<data::Volume>> outs(graph.writers.size());
+                        for (auto &out : outs)
+                            out = std::make_shared<data::Volume>();
+
+                        for (cl_uint z0 = 0; z0 < source->width; z0 += core)
+                        {
+                            cl_uint z1 = std::min(z0 + core, source->width);
+                            cl_uint from = z0 - std::min(z0, halo);
+                            cl_uint to = std::min(z1 + halo, source->width);
+
+                            auto in = std::make_shared<data::Volume>();
+                            in->mirror(*source);
+                            in->rFrame = f;
+                            in->width = to - from;
+                            in->buffer = cl::Buffer(device.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, plane * in->width, reinterpret_cast<cl_uchar *>(source->raw[f].data()) + plane * from);
+
+                            for (auto &[k, parent] : graph.nodes)
+                            {
+                                k->filter->volume = k->volume;
+                                k->filter->input(graph.input(parent, in));
+                                k->filter->execute();
+                            }
+
+                            for (std::size_t w = 0; w < outs.size(); ++w)
+                            {
+                                auto &result = graph.input(graph.writers[w].second, in);
+                                if (outs[w]->raw.empty())
+                                {
+                                    outs[w]->mirror(*result);
+                                    outs[w]->width = source->width;
+                                    outs[w]->raw.emplace_back(plane / sizeof(cl_uchar4) * source->width);
+                                }
+                                device.cQueue.enqueueReadBuffer(result->buffer, CL_TRUE, plane * (z0 - from), plane * (z1 - z0), reinterpret_cast<cl_uchar *>(outs[w]->raw[0].data()) + plane * z0);
+                            }
+                        }
+
+                        for (std::size_t w = 0; w < outs.size(); ++w)
+                        {
+                            outs[w]->rFrame = f;
+                            graph.writers[w].first->execute(outs[w], true);
+                        }
+                    }
+                }
+                catch (const cl::Error &e)
+                {
+                    std::cerr << "Export, " << e.what() << " : " << e.err() << ", slab export abandoned." << std::endl;
+                    graph.reset();
+                    continue;
+                }
+
+                graph.reset();
+
+                auto stop = std::chrono::steady_clock::now();
+                float ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(stop - start).count();
+                std::cout << "Export Time: " << ms << "ms, " << static_cast<float>(source->frames) * 1000.0f / ms << " fps (slabs of " << core << " + 2x" << halo << " planes)" << std::endl;
+                continue;
+            }
+
+            // Small exams (2D, tests/data/1) are launch bound, pack enough frames that one enqueue covers ~1M voxels.
+            cl_uint frameSize = source->depth * source->length * source->width;
+            cl_uint frameBatch = batch ? batch : std::clamp((1u << 20) / std::max(frameSize, 1u), 1u, 64u);
+            frameBatch = std::min(frameBatch, std::max(source->frames, 1u));
+            cl_uint batches = (source->frames + frameBatch - 1) / frameBatch;
+
+            // Separate queues so transfers overlap the filter chain on device.cQueue.
+            cl::CommandQueue upQueue(device.context);
+            cl::CommandQueue downQueue(device.context);
+
+            data::Pipeline<Item> pipeline;
+            pipeline.pipelined = pipelined;
+
+            pipeline
+                .addStage( // Upload
+                    [&](Item &item)
+                    {
+                        item.volume->buffer = opencl::Arena::allocate(device.context, sizeof(cl_uchar4) * frameSize * item.count);
+                        for (cl_uint i = 0; i < item.count; ++i)
+                        {
+                            upQueue.enqueueWriteBuffer(item.volume->buffer, CL_FALSE, sizeof(cl_uchar4) * frameSize * i, sizeof(cl_uchar4) * frameSize, source->raw[item.frame + i].data(), nullptr, &item.event);
+                        }
+                        upQueue.flush();
+                    })
+                .addStage( // Filter graph, every branch off the same upstream buffers
+                    [&](Item &item)
+                    {
+                        std::vector<cl::Event> wait{item.event};
+                        device.cQueue.enqueueBarrierWithWaitList(&wait);
+
+                        for (auto &[k, parent] : graph.nodes)
+                        {
+                            k->filter->volume = k->volume;
+                            k->filter->input(graph.input(parent, item.volume));
+                            k->filter->execute();
+                        }
+
+                        // Node volumes are reused by the next frame, keep this frame's results.
+                        for (auto &writer : graph.writers)
+                        {
+                            auto &in = graph.input(writer.second, item.volume);
+                            auto result = std::make_shared<data::Volume>();
+                            result->mirror(*in);
+                            result->buffer = in->buffer;
+                            item.results.push_back(std::move(result));
+                        }
+
+                        device.cQueue.enqueueMarkerWithWaitList(nullptr, &item.event);
+                        device.cQueue.flush();
+                    })
+                .addStage( // Readback
+                    [&](Item &item)
+                    {
+                        std::vector<cl::Event> wait{item.event};
+                        for (auto &result : item.results)
+                        {
+                            auto bSize = result->buffer.getInfo<CL_MEM_SIZE>();
+                            result->raw.resize(1);
+                            result->raw[0].resize(bSize / sizeof(cl_uchar4));
+                            downQueue.enqueueReadBuffer(result->buffer, CL_TRUE, 0, bSize, result->raw[0].data(), &wait);
+                            result->buffer = cl::Buffer();
+                        }
+                    })
+                .addStage( // Write, unpacking the batch
+                    [&](Item &item)
+                    {
+                        for (std::size_t w = 0; w < graph.writers.size(); ++w)
+                        {
+                            auto &result = item.results[w];
+                            std::size_t outSize = static_cast<std::size_t>(result->depth) * result->length * result->width;
+                            for (cl_uint i = 0; i < item.count; ++i)
+                            {
+                                auto out = std::make_shared<data::Volume>();
+                                out->mirror(*result);
+                                out->batch = 1;
+                                out->rFrame = item.frame + i;
+                                out->raw.emplace_back(result->raw[0].begin() + static_cast<std::ptrdiff_t>(outSize * i), result->raw[0].begin() + static_cast<std::ptrdiff_t>(outSize * (i + 1)));
+                                graph.writers[w].first->execute(out, true);
+                            }
+                        }
+                    });
+
+            auto start = std::chrono::steady_clock::now();
+
+            try
+            {
+                pipeline.run(
+                    batches,
+                    [&](unsigned int b)
+                    {
+                        // Host decode, Mindray frames are already unpacked so this is only the header.
+                        cl_uint frame = b * frameBatch;
+                        Item item{frame, std::min(frameBatch, source->frames - frame), std::make_shared<data::Volume>(), cl::Event(), {}};
+                        item.volume->mirror(*source);
+                        item.volume->rFrame = frame;
+                        item.volume->batch = item.count;
+                        return item;
+                    });
+            }
+            catch (const cl::Error &e)
+            {
+                std::cerr << "Export, " << e.what() << " : " << e.err() << ", export abandoned." << std::endl;
+                graph.reset();
+                continue;
+            }
+
+            graph.reset();
+
+            auto stop = std::chrono::steady_clock::now();
+            float ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(stop - start).count();
+            std::cout << "Export Time: " << ms << "ms, " << static_cast<float>(source->frames) * 1000.0f / ms << " fps (" << (pipelined ? "pipelined" : "serial") << ", batch " << frameBatch << ")" << std::endl;
+        }
+    }
+
+    void Kernel::exportKernels(opencl::DeviceGroup &group)
+    {
+        for (auto &wptr : xKernels)
+        {
+            auto head = wptr.lock();
+            if (!head)
+                continue;
+
+            // Every filter that can be rebuilt on another device runs on the group, the writers stay here and
+            // receive the frames in order.
+            Graph graph(*head);
+            if (graph.nodes.empty() || graph.writers.empty())
+                continue;
+
+            std::shared_ptr<data::Volume> source = head->volume;
+            std::vector<std::vector<std::shared_ptr<opencl::Filter>>> chains(group.devices.size());
+
+            auto start = std::chrono::steady_clock::now();
+
+            try
+            {
+                group.process(
+                    source->frames,
+                    [&](std::size_t d, cl_uint frame)
+                    {
+                        opencl::Device &device = *group.devices[d];
+                        auto &chain = chains[d];
+                        if (chain.empty())
+                        {
+                            for (auto &node : graph.nodes)
+                            {
+                                chain.push_back(node.first->filter->replicate(device));
+                                chain.back()->volume = std::make_shared<data::Volume>();
+                            }
+                        }
+
+                        auto v = std::make_shared<data::Volume>();
+                        v->mirror(*source);
+                        v->rFrame = frame;
+                        v->buffer = cl::Buffer(device.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(cl_uchar4) * source->raw[frame].size(), source->raw[frame].data());
+
+                        auto in = [&](std::size_t parent) -> std::shared_ptr<data::Volume> &
+                        { return parent == Graph::fromSource ? v : chain[parent]->volume; };
+
+                        for (std::size_t n = 0; n < chain.size(); ++n)
+                        {
+                            chain[n]->input(in(graph.nodes[n].second));
+                            chain[n]->execute();
+                        }
+
+                        std::vector<std::shared_ptr<data::Volume>> outs;
+                        for (auto &writer : graph.writers)
+                        {
+                            auto &result = in(writer.second);
+                            auto out = std::make_shared<data::Volume>();
+                            out->mirror(*result);
+                            out->raw.push_back(result->loadFromCl(device.cQueue));
+                            outs.push_back(std::move(out));
+                        }
+                        return outs;
+                    },
+                    [&](cl_uint frame, std::vector<std::shared_ptr<data::Volume>> &&outs)
+                    {
+                        for (std::size_t w = 0; w < outs.size(); ++w)
+                        {
+                            outs[w]->rFrame = frame;
+                            graph.writers[w].first->execute(outs[w], true);
+                        }
+                    });
+            }
+            catch (const cl::Error &e)
+            {
+                std::cerr << "Group Export, " << e.what() << " : " << e.err() << ", export abandoned." << std::endl;
+                graph.reset();
+                continue;
+            }
+
+            graph.reset();
+
+            auto stop = std::chrono::steady_clock::now();
+            std::cout << "Group Export Time: " << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(stop - start).count() << "ms (" << group.devices.size() << " devices)" << std::endl;
+        }
+    }
+
+    void Kernel::updateLine(gui::Rectangle &line, float ox, float oy)
+    {
+        float newX = x + w;
+        float newY = outNode->y + outNode->h / 2.0f - line.h / 2.0f;
+        line.angle = std::atan2(oy - newY, ox - newX);
+        line.update(
+            newX - line.x,
+            newY - line.y,
+            std::sqrt((oy - line.y) * (oy - line.y) + (ox - line.x) * (ox - line.x)) - line.w,
+            0.0f);
+    }
+
+    void Kernel::updateLines()
+    {
+        for (std::size_t i = 0; i < outLinks.size(); ++i)
+            updateLine(outLines[i], outLinks[i]->inNode->x, outLinks[i]->inNode->y + outLinks[i]->inNode->h / 2.0f);
+    }
+
+    void Kernel::unlink(const std::shared_ptr<Kernel> &k)
+    {
+        auto itr = std::find(outLinks.begin(), outLinks.end(), k);
+        if (itr == outLinks.end())
+            return;
+
+        outLines.erase(outLines.begin() + (itr - outLinks.begin()));
+        outLinks.erase(itr);
+        k->inLink.reset();
+
+        // Two graphs now, both see the change.
+        root().generation = ++generations;
+        k->generation = ++generations;
+    }
+
+    Kernel &Kernel::root()
+    {
+        Kernel *k = this;
+        while (k->inLink)
+            k = k->inLink.get();
+        return *k;
+    }
+
+    const Kernel &Kernel::root() const
+    {
+        const Kernel *k = this;
+        while (k->inLink)
+            k = k->inLink.get();
+        return *k;
+    }
+
+    void Kernel::edited()
+    {
+        ++edits;
+        root().generation = ++generations;
+    }
+
+    std::uint64_t Kernel::graphGeneration() const
+    {
+        return root().generation;
+    }
+
+    void Kernel::draw()
+    {
+        Rectangle::upload();
+        title.upload();
+        renderButton->draw();
+        inNode->draw();
+        outNode->draw();
+        options->draw();
+
+        for (auto &line : outLines)
+            line.upload();
+
+        if (!outLine.hidden)
+        {
+            outLine.upload();
+        }
+    }
+
+    std::shared_ptr<Kernel> Kernel::build(std::shared_ptr<opencl::Filter> &&f, std::shared_ptr<Texture> &&tptr)
+    {
+        auto sptr = std::shared_ptr<Kernel>(new Kernel(std::move(f), std::forward<std::shared_ptr<Texture>>(tptr)));
+        sptr->Rectangle::draw = std::bind(Kernel::draw, sptr.get());
+        sptr->Rectangle::resize = std::bind(update, sptr.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+
+        sptr->eventManager->addCallback(
+            SDL_MOUSEBUTTONDOWN,
+            [wptr = sptr->weak_from_this()](const SDL_Event &e)
+            {
+                auto ptr = wptr.lock();
+                if (events::containsMouse(std::as_const(*ptr->outNode), e))
+                {
+                    ptr->updateLine(ptr->outLine, static_cast<float>(e.motion.x), static_cast<float>(e.motion.y));
+                    ptr->outLine.hidden = false;
+                    ptr->link = true;
+                    ptr->outNode->eventManager->process(e);
+                    return;
+                }
+                else if (events::containsMouse(std::as_const(*ptr->options), e))
+                {
+                    std::uint64_t before = changes;
+                    ptr->h = ptr->h - ptr->options->h;
+                    ptr->options->eventManager->process(e);
+                    ptr->optionEvent = ptr->options->subManager;
+                    ptr->h = ptr->h + ptr->options->h;
+                    ptr->Rectangle::update();
+                    if (changes != before)
+                        ptr->edited();
+                }
+                else
+                {
+                    ptr->link = false;
+                    ptr->move = true;
+                }
+            });
+
+        sptr->eventManager->addCallback(
+            SDL_DROPFILE,
+            [wptr = sptr->weak_from_this()](const SDL_Event &e)
+            {
+                auto ptr = wptr.lock();
+                ptr->filter->volume = ptr->volume;
+                if (!ptr->filter->load(e.drop.file))
+                {
+                    SDL_free(e.drop.file);
+                    return;
+                }
+                
+                SDL_free(e.drop.file);
+
+                for (auto itr = xKernels.begin(); itr != xKernels.end(); ++itr)
+                {
+                    if (itr->lock() == ptr)
+                    {
+                        xKernels.erase(itr);
+                        break;
+                    }
+                }
+
+                xKernels.push_back(wptr);
+
+                ptr->modified = true;
+                ptr->edited(); // New data under the same frame numbers
+
+                executeKernels(0);
+            });
+
+        sptr->eventManager->addCallback(
+            SDL_MOUSEBUTTONUP,
+            [wptr = sptr->weak_from_this()](const SDL_Event &e)
+            {
+                auto ptr = wptr.lock();
+                ptr->move = false;
+                if (!ptr)
+                    return;
+
+                auto optr = ptr->optionEvent.lock();
+                if (optr)
+                {
+                    std::uint64_t before = changes;
+                    optr->process(e);
+                    ptr->optionEvent.reset();
+                    if (changes != before)
+                        ptr->edited();
+                }
+                else if (events::containsMouse(std::as_const(*ptr->renderButton), e))
+                {
+                    ptr->renderButton->eventManager->process(e);
+                    return;
+                }
+            });
+
+        sptr->eventManager->addCallback(
+            SDL_MOUSEMOTION,
+            [wptr = sptr->weak_from_this()](const SDL_Event &e)
+            {
+                auto ptr = wptr.lock();
+                auto optr = ptr->optionEvent.lock();
+
+                if (ptr->link)
+                {
+                    ptr->updateLine(ptr->outLine, static_cast<float>(e.motion.x), static_cast<float>(e.motion.y));
+                }
+                else if (optr)
+                {
+                    std::uint64_t before = changes;
+                    optr->process(e);
+                    if (changes != before)
+                        ptr->edited();
+                }
+                else if (ptr->move)
+                {
+                    ptr->resize(static_cast<float>(e.motion.xrel), static_cast<float>(e.motion.yrel), 0.0f, 0.0f);
+                }
+            });
+        return sptr;
+    }
+
+    // Dropping on a node adds it as another consumer, or removes it when already one. Anywhere else cancels.
+    bool Kernel::endLink(const SDL_Event &e, std::shared_ptr<Kernel> &k)
+    {
+        link = false;
+        outLine.hidden = true;
+
+        if (k.get() == this || !events::containsMouse(*k, e))
+            return false;
+
+        if (k->inLink.get() == this)
+        {
+            unlink(k);
+            return true;
+        }
+
+        if (k->inLink)
+            k->inLink->unlink(k);
+
+        outLinks.push_back(k);
+        k->inLink = shared_from_this();
+        root().generation = ++generations;
+
+        outLines.emplace_back(0.0f, 0.0f, 0.0f, 3.0f);
+        outLines.back().texture->fill({0xD3, 0xD3, 0xD3, 0xFF});
+        updateLine(outLines.back(), k->inNode->x, k->inNode->y + k->inNode->h / 2.0f);
+
+        // When executing will allow a save to occur
+        k->modified = true;
+
+        return true;
+    }
+
+    Kernel::Kernel(std::shared_ptr<opencl::Filter> &&f, std::shared_ptr<Texture> &&tptr) : Rectangle(0.0f, 0.0f, 40.0f, 40.0f), filter(std::forward<std::shared_ptr<opencl::Filter>>(f)), outLine({0.0f, 0.0f, 0.0f, 3.0f}), title(0.0f, 0.0f, static_cast<float>(tptr->textureW), static_cast<float>(tptr->textureH), std::forward<std::shared_ptr<Texture>>(tptr))
+    {
+        home = filter->queue;
+        texture->fill({0x5C, 0x5C, 0x5C, 0xFF});
+
+        inNode = (Button::build("IN"));
+        outNode = (Button::build("-->"));
+        renderButton = (Button::build("+"));
+
+        w = std::max(w, title.w + renderButton->w + 2.0f);
+        h = title.h * 3.0f;
+
+        options = filter->getOptions();
+
+        // Filter nodes can keep their frames for scrubbing and re-rendering, see data::FrameCache.
+        if (filter->replicate)
+        {
+            auto cacheButton = Button::build("CACHE");
+            cacheButton->edits = false; // Keeping frames changes no output
+            cacheButton->onPress([this]()
+                                 {
+                                     cache = !cache;
+                                     if (!cache)
+                                         data::FrameCache::drop(this); });
+            options->addLeaf(std::move(cacheButton));
+        }
+
+        if (options->empty())
+        {
+            options->hidden = true;
+        }
+        else
+        {
+            w = std::max(w, options->w);
+        }
+
+        int mx, my;
+        SDL_GetMouseState(&mx, &my);
+
+        x = static_cast<float>(mx) - w / 2.0f;
+        y = static_cast<float>(my) - h / 2.0f;
+        
+        if (!options->empty())
+        {
+            options->resize(x - options->x, y + h - options->y, 0.0f, 0.0f);
+            h = h + options->h;
+            
+            inNode->resize(
+                x + 2.0f - inNode->x,
+                y + (h - options->h) / 2.0f - inNode->y, 0.0f, 0.0f);
+            outNode->resize(
+                x + w - 2.0f - outNode->w - outNode->x,
+                y + (h - options->h) / 2.0f - outNode->y, 0.0f, 0.0f);
+        }
+        else
+        {
+            inNode->resize(
+                x + 2.0f - inNode->x,
+                y + h / 2.0f - inNode->y, 0.0f, 0.0f);
+            outNode->resize(
+                x + w - 2.0f - outNode->w - outNode->x,
+                y + h / 2.0f - outNode->y, 0.0f, 0.0f);
+        }
+
+        title.update(x + w / 2.0f - title.w / 2.0f - renderButton->w / 2.0f - 1.0f - title.x,
+                     y - title.y);
+        renderButton->resize(
+            title.x + title.w + 2.0f - renderButton->x,
+            title.y - renderButton->y, 0.0f, 0.0f);
+
+        outLine.hidden = true;
+        outLine.texture->fill({0xD3, 0xD3, 0xD3, 0xFF});
+
+        Rectangle::update();
+
+        arm = std::bind(filter->input, std::placeholders::_1);
+    }
+
+    Kernel::~Kernel()
+    {
+        data::FrameCache::drop(this);
+    }
+
+    void Kernel::execute(std::shared_ptr<data::Volume> &sp, bool m)
+    {
+        active = true;
+        if (m == true)
+            modified = m;
+
+        // Loaders are handed their own volume, their output only depends on the frame and options.
+        bool loader = !sp || sp == volume;
+        Stamp now{loader ? nullptr : sp.get(), loader ? 0 : sp->version, loader ? volume->rFrame : sp->rFrame, edits};
+
+        // Only nodes downstream of a change run, the rest pass their last output on untouched.
+        if (modified || last != now)
+        {
+            // Loaders already hold every frame, anything else may have this one cached.
+            data::FrameCache::key_t key{this, now.source, now.version, now.frame, now.edits};
+            bool cached = cache && !loader;
+
+            if (!cached || modified || !data::FrameCache::fetch(key, *volume))
+            {
+                filter->volume = volume;
+
+                // The arena has already evicted what it could, the node sits out until its inputs change.
+                try
+                {
+                    if (sp)
+                        arm(sp);
+
+                    filter->toggle = modified;
+                    filter->execute();
+                }
+                catch (const cl::Error &e)
+                {
+                    std::cerr << "Kernel, " << e.what() << " : " << e.err() << '\n';
+                    active = false;
+                    last = now;
+                    modified = false;
+                    return;
+                }
+
+                volume->version = version(now);
+                if (cached)
+                    data::FrameCache::store(key, *volume, filter->queue);
+            }
+            last = now;
+        }
+
+        // Branches read volume as it is, the frame is shared rather than recomputed per consumer. The first
+        // consumer carries on on this node's queue, the others each get a queue of their own that starts once
+        // volume is ready, and this queue waits for all of them so whatever reads it next sees every branch.
+        cl::CommandQueue queue = filter->queue() != nullptr || outLinks.empty() ? filter->queue : outLinks.front()->home;
+        if (outLinks.size() < 2 || queue() == nullptr)
+        {
+            for (auto &k : outLinks)
+            {
+                if (queue() != nullptr)
+                    k->filter->queue = queue;
+                k->execute(volume, modified);
+            }
+            modified = false;
+            return;
+        }
+
+        std::vector<cl::Event> ready(1), joins(outLinks.size() - 1);
+        try
+        {
+            while (branches.size() + 1 < outLinks.size())
+                branches.emplace_back(queue.getInfo<CL_QUEUE_CONTEXT>(), queue.getInfo<CL_QUEUE_DEVICE>());
+            queue.enqueueMarkerWithWaitList(nullptr, &ready[0]);
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Kernel, " << e.what() << " : " << e.err() << ", branches run in turn.\n";
+            branches.clear();
+        }
+
+        for (std::size_t i = 0; i < outLinks.size(); ++i)
+        {
+            auto &k = outLinks[i];
+            if (i == 0 || branches.empty())
+            {
+                k->filter->queue = queue;
+                k->execute(volume, modified);
+                continue;
+            }
+
+            cl::CommandQueue &branch = branches[i - 1];
+            branch.enqueueBarrierWithWaitList(&ready);
+            k->filter->queue = branch;
+            k->execute(volume, modified);
+            branch.enqueueMarkerWithWaitList(nullptr, &joins[i - 1]);
+            branch.flush();
+        }
+
+        if (!branches.empty())
+            queue.enqueueBarrierWithWaitList(&joins);
+
+        modified = false;
+    }
+
+    // Same inputs, same output: a recomputed frame keeps its version, so the stamps and cached frames
+    // downstream of it stay valid.
+    std::uint64_t Kernel::version(const Stamp &s) const
+    {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        for (std::uint64_t word : {static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(this)), static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(s.source)), s.version, static_cast<std::uint64_t>(s.frame), s.edits})
+        {
+            hash = (hash ^ word) * 0x100000001B3ull;
+            hash ^= hash >> 29;
+        }
+        return hash;
+    }
+
+    void Kernel::update(float dx, float dy, float dw, float dh)
+    {
+        Rectangle::update(dx, dy, dw, dh);
+        inNode->resize(dx, dy, dw, dh);
+        outNode->resize(dx, dy, dw, dh);
+        // outLine.update(dx, dy, dw, dh);
+        title.update(dx, dy, dw, dh);
+        renderButton->resize(dx, dy, dw, dh);
+        options->resize(dx, dy, dw, dh);
+
+        updateLines();
+
+        if (inLink)
+            inLink->updateLines();
+    }
+
+    std::shared_ptr<Renderer> Kernel::buildRenderer(std::vector<std::shared_ptr<Renderer>> &wr)
+    {
+
+        if (active)
+        {
+            try
+            {
+                // Host filters (native backend) keep their frame in raw instead.
+                if (volume->buffer() != nullptr || volume->raw.empty())
+                    volume->buffer.template getInfo<CL_MEM_SIZE>();
+                return Renderer::build(wr, {0.0f, 0.0f, 1.0f, 1.0f, std::make_shared<gui::Texture>(512, 512)}, std::shared_ptr(filter->volume), shared_from_this());
+            }
+            catch (const cl::Error &e)
+            {
+                SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Render Error", "This kernel does not store a valid volume.", nullptr);
+            }
+        }
+        else
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "Render Information", "This kernel is currently inactive. Ultrasound data must be processed by this kernel before it can be displayed.", nullptr);
+        }
+
+        return std::shared_ptr<Renderer>(nullptr);
+    }
+
 } // namespace gui
\ No newline at end of file
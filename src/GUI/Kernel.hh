@@ -1,99 +1,145 @@
-#ifndef GUI_KERNEL_HH
-#define GUI_KERNEL_HH
-
-#include <functional>
-#include <string>
-#include <memory>
-#include <vector>
-
-#include <glm/ext.hpp>
-
-#include "Rectangle.hh"
-#include "Button.hh"
-#include "Texture.hh"
-// #include "Renderer.hh"
-#include "Tree.hh"
-#include "Slider.hh"
-
-#include "../Data/Volume.hh"
-#include "../OpenCL/Kernel.hh"
-#include "../OpenCL/Filter.hh"
-#include "../events/EventManager.hh"
-#include "../OpenCL/Concepts.hh"
-
-#include "../OpenCL/Kernels/ToPolar.hh"
-#include "../OpenCL/Kernels/ToCartesian.hh"
-#include "../OpenCL/Kernels/Slice.hh"
-#include "../OpenCL/Kernels/Invert.hh"
-#include "../OpenCL/Kernels/Contrast.hh"
-#include "../OpenCL/Kernels/Log2.hh"
-#include "../OpenCL/Kernels/Shrink.hh"
-#include "../OpenCL/Kernels/Fade.hh"
-#include "../OpenCL/Kernels/Sqrt.hh"
-#include "../OpenCL/Kernels/Clamp.hh"
-#include "../OpenCL/Kernels/Threshold.hh"
-
-#include "../Ultrasound/Mindray.hh"
-
-namespace
-{
-    using namespace opencl;
-    using namespace ultrasound;
-}
-
-namespace gui
-{
-
-    class Renderer;
-    class Dropzone;
-
-    class Kernel : public Rectangle, public std::enable_shared_from_this<Kernel>
-    {
-    private:
-        Kernel(std::shared_ptr<opencl::Filter> &&f, std::shared_ptr<Texture> &&tptr);
-
-        bool move = true;
-        std::weak_ptr<events::EventManager> optionEvent;
-        bool active = false;
-        bool modified = true;
-        std::shared_ptr<data::Volume> volume = std::make_shared<data::Volume>();
-
-    public:
-        std::shared_ptr<opencl::Filter> filter;
-        std::function<void(std::shared_ptr<data::Volume> &, bool)> fire;
-        std::function<void(std::shared_ptr<data::Volume> &)> arm;
-        static std::vector<std::weak_ptr<Kernel>> xKernels;
-
-        std::shared_ptr<Button> inNode;
-        std::shared_ptr<Button> outNode;
-        std::shared_ptr<Button> renderButton;
-
-        gui::Rectangle outLine;
-        gui::Rectangle title;
-
-        std::shared_ptr<Kernel> inLink;
-        std::shared_ptr<Kernel> outLink;
-
-        std::shared_ptr<Tree> options;
-
-        bool link = false;
-
-
-        void updateLine(float ox, float oy);
-        void draw();
-
-        static std::shared_ptr<Kernel> build(std::shared_ptr<opencl::Filter> &&f, std::shared_ptr<Texture> &&tptr);        
-
-        ~Kernel() = default;
-
-        void execute(std::shared_ptr<data::Volume> &sp, bool m);
-        void update(float, float, float, float);
-
-        bool endLink(const SDL_Event &e, std::shared_ptr<Kernel> &k);
-        std::shared_ptr<Renderer> buildRenderer(std::vector<std::shared_ptr<Renderer>> &wr);
-
-        static void executeKernels(cl_uint i);
-    };
-
-}
+#ifndef GUI_KERNEL_HH
+#define GUI_KERNEL_HH
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <glm/ext.hpp>
+
+#include "Rectangle.hh"
+#include "Button.hh"
+#include "Texture.hh"
+// #include "Renderer.hh"
+#include "Tree.hh"
+#include "Slider.hh"
+
+#include "../Data/Volume.hh"
+#include "../OpenCL/Kernel.hh"
+#include "../OpenCL/Filter.hh"
+#include "../events/EventManager.hh"
+#include "../OpenCL/Concepts.hh"
+
+#include "../OpenCL/Kernels/ToPolar.hh"
+#include "../OpenCL/Kernels/ToCartesian.hh"
+#include "../OpenCL/Kernels/Slice.hh"
+#include "../OpenCL/Kernels/Invert.hh"
+#include "../OpenCL/Kernels/Contrast.hh"
+#include "../OpenCL/Kernels/Log2.hh"
+#include "../OpenCL/Kernels/Shrink.hh"
+#include "../OpenCL/Kernels/Fade.hh"
+#include "../OpenCL/Kernels/Sqrt.hh"
+#include "../OpenCL/Kernels/Clamp.hh"
+#include "../OpenCL/Kernels/Threshold.hh"
+
+#include "../Ultrasound/Mindray.hh"
+
+namespace opencl
+{
+    class Device;
+    class DeviceGroup;
+}
+
+namespace
+{
+    using namespace opencl;
+    using namespace ultrasound;
+}
+
+namespace gui
+{
+
+    class Renderer;
+    class Dropzone;
+
+    class Kernel : public Rectangle, public std::enable_shared_from_this<Kernel>
+    {
+    private:
+        Kernel(std::shared_ptr<opencl::Filter> &&f, std::shared_ptr<Texture> &&tptr);
+
+        bool move = true;
+        std::weak_ptr<events::EventManager> optionEvent;
+        bool active = false;
+        bool modified = true;
+        std::shared_ptr<data::Volume> volume = std::make_shared<data::Volume>();
+
+        // What the last run of the filter consumed, execute reuses volume while it still matches.
+        struct Stamp
+        {
+            const data::Volume *source; // Null for loaders
+            std::uint64_t version;
+            cl_uint frame;
+            std::uint64_t edits;
+
+            bool operator==(const Stamp &) const = default;
+        };
+        std::optional<Stamp> last;
+        std::uint64_t edits = 0; // Option events that moved a slider or pressed a button
+        bool cache = false;      // Keep processed frames in data::FrameCache, toggled from the options
+
+        std::uint64_t generation = 0; // Of the graph, kept on its loader (see graphGeneration)
+        static std::uint64_t generations;
+
+        std::uint64_t version(const Stamp &s) const;
+
+        struct Graph; // What an export runs under a loader
+
+        Kernel &root();
+        const Kernel &root() const;
+        void edited();
+
+    public:
+        std::shared_ptr<opencl::Filter> filter;
+        std::function<void(std::shared_ptr<data::Volume> &)> arm;
+        static std::vector<std::weak_ptr<Kernel>> xKernels;
+
+        std::shared_ptr<Button> inNode;
+        std::shared_ptr<Button> outNode;
+        std::shared_ptr<Button> renderButton;
+
+        gui::Rectangle outLine; // While dragging a new link
+        gui::Rectangle title;
+
+        // Every consumer reads this node's volume, computed once per frame, one line each.
+        std::shared_ptr<Kernel> inLink;
+        std::vector<std::shared_ptr<Kernel>> outLinks;
+        std::vector<gui::Rectangle> outLines;
+
+        cl::CommandQueue home;                  // The filter's own queue, for when the node is not on a branch
+        std::vector<cl::CommandQueue> branches; // Of the second and later consumers, so branches overlap on the device
+
+        std::shared_ptr<Tree> options;
+
+        bool link = false;
+
+
+        void updateLine(gui::Rectangle &line, float ox, float oy);
+        void updateLines();
+        void unlink(const std::shared_ptr<Kernel> &k);
+
+        // Changes with every edit, load or link anywhere in this node's graph, frames computed under an older
+        // one are stale.
+        std::uint64_t graphGeneration() const;
+        void draw();
+
+        static std::shared_ptr<Kernel> build(std::shared_ptr<opencl::Filter> &&f, std::shared_ptr<Texture> &&tptr);        
+
+        ~Kernel();
+
+        void execute(std::shared_ptr<data::Volume> &sp, bool m);
+        void update(float, float, float, float);
+
+        bool endLink(const SDL_Event &e, std::shared_ptr<Kernel> &k);
+        std::shared_ptr<Renderer> buildRenderer(std::vector<std::shared_ptr<Renderer>> &wr);
+
+        static void executeKernels(cl_uint i);
+        // Frames bigger than slab bytes (0 for the device's largest allocation) go through the chain in z-slabs.
+        static void exportKernels(opencl::Device &device, bool pipelined = true, cl_uint batch = 0, std::size_t slab = 0);
+        static void exportKernels(opencl::DeviceGroup &group);
+    };
+
+}
 #endif
\ No newline at end of file
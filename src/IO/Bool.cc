@@ -1,15 +1,15 @@
-#include "Bool.hh"
-
-namespace io
-{
-    Bool::operator bool() const
-    {
-        return b;
-    }
-
-    auto operator<<(std::ostream &os, const Bool &b) -> std::ostream &
-    {
-        return os << b.b;
-    }
-
+#include "Bool.hh"
+
+namespace io
+{
+    Bool::operator bool() const
+    {
+        return b;
+    }
+
+    auto operator<<(std::ostream &os, const Bool &b) -> std::ostream &
+    {
+        return os << b.b;
+    }
+
 } // namespace io
\ No newline at end of file
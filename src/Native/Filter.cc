@@ -0,0 +1,41 @@
+#include "Filter.hh"
+
+namespace native
+{
+
+    Filter::Filter() : shape{0, 0, 0}
+    {
+        opencl::Filter::input = [this](const std::weak_ptr<data::Volume> &wv)
+        { accept(wv); };
+    }
+
+    // Same shape and header as the input, filters that resize set the dimensions after.
+    bool Filter::accept(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return false;
+
+        source = v;
+        shape = {v->depth, v->length, v->width};
+
+        volume->mirror(*v);
+        volume->batch = 1;
+        volume->buffer = cl::Buffer();
+        volume->image = cl::Image3D();
+        return true;
+    }
+
+    const frame_t &Filter::in() const
+    {
+        return source->host();
+    }
+
+    frame_t &Filter::out()
+    {
+        volume->raw.resize(1);
+        volume->raw[0].resize(static_cast<std::size_t>(volume->depth) * volume->length * volume->width);
+        return volume->raw[0];
+    }
+
+} // namespace native
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef NATIVE_FILTER_HH
+#define NATIVE_FILTER_HH
+
+#include <memory>
+
+#include "Kernels.hh"
+
+#include "../OpenCL/Filter.hh"
+#include "../Data/Volume.hh"
+
+namespace native
+{
+
+    // Host filters keep their result in volume->raw instead of a buffer, a frame per execute. Inputs are read
+    // through Volume::host so a reader's exam and another filter's single frame look the same.
+    class Filter : public opencl::Filter
+    {
+    protected:
+        std::shared_ptr<data::Volume> source;
+        Shape shape; // Of the input
+
+        Filter();
+        ~Filter() = default;
+
+        bool accept(const std::weak_ptr<data::Volume> &wv);
+        const frame_t &in() const;
+        frame_t &out();
+    };
+
+} // namespace native
+
+#endif
\ No newline at end of file
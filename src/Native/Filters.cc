@@ -0,0 +1,307 @@
+#include "Filters.hh"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "../GUI/Button.hh"
+#include "../OpenCL/Kernels/Gaussian.hh"
+#include "../OpenCL/Kernels/ToPolar.hh"
+#include "../OpenCL/Kernels/ToCartesian.hh"
+
+namespace native
+{
+
+    Pass::Pass(const op_t &o, const std::vector<std::shared_ptr<gui::Slider>> &s) : op(o), sliders(s)
+    {
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::replicate = [this](const opencl::Device &) -> std::shared_ptr<opencl::Filter>
+        { return std::make_shared<Pass>(op, sliders); };
+    }
+
+    void Pass::execute()
+    {
+        if (!source)
+            return;
+
+        op(shape, in(), out(), *volume);
+    }
+
+    std::shared_ptr<gui::Tree> Pass::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+        for (auto &s : sliders)
+        {
+            s->resize(0.0f, 0.0f, options->w, 0.0f);
+            options->addLeaf(s);
+        }
+        return options;
+    }
+
+    Morphology::Morphology()
+    {
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::replicate = [this](const opencl::Device &) -> std::shared_ptr<opencl::Filter>
+        {
+            auto f = std::make_shared<Morphology>();
+            f->operation = operation;
+            f->sliders = sliders;
+            return f;
+        };
+
+        operation = std::make_shared<Operation>(Operation::Erode);
+        for (auto &s : sliders)
+        {
+            s = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+            s->value = 0.125f;
+        }
+    }
+
+    // One erosion or dilation, radius 0 to 8 voxels per axis as in opencl::Morphology.
+    void Morphology::pass(std::vector<cl_uchar> &alpha, bool dilate)
+    {
+        for (cl_uint axis = 0; axis < (shape.width == 1 ? 2u : 3u); ++axis)
+        {
+            cl_uint r = static_cast<cl_uint>(std::lround(sliders[axis]->value * 8.0f));
+            if (r != 0)
+                morphologyLine(shape, alpha, axis, r, dilate);
+        }
+    }
+
+    void Morphology::execute()
+    {
+        if (!source)
+            return;
+
+        const frame_t &frame = in();
+        std::vector<cl_uchar> alpha(frame.size());
+        std::transform(frame.begin(), frame.end(), alpha.begin(), [](const cl_uchar4 &v)
+                       { return v.s[3]; });
+
+        switch (*operation)
+        {
+        case Operation::Erode:
+            pass(alpha, false);
+            break;
+        case Operation::Dilate:
+            pass(alpha, true);
+            break;
+        case Operation::Open:
+            pass(alpha, false);
+            pass(alpha, true);
+            break;
+        case Operation::Close:
+            pass(alpha, true);
+            pass(alpha, false);
+            break;
+        }
+
+        frame_t &output = out();
+        for (std::size_t i = 0; i < output.size(); ++i)
+        {
+            output[i] = frame[i];
+            output[i].s[3] = alpha[i];
+        }
+    }
+
+    std::shared_ptr<gui::Tree> Morphology::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+
+        const std::pair<const char *, Operation> ops[] = {{"ERODE", Operation::Erode}, {"DILATE", Operation::Dilate}, {"OPEN", Operation::Open}, {"CLOSE", Operation::Close}};
+        for (const auto &[name, op] : ops)
+        {
+            auto button = gui::Button::build(name);
+            button->onPress([target = operation, choice = op]()
+                            { *target = choice; });
+            options->addLeaf(std::move(button));
+        }
+
+        for (auto &s : sliders)
+        {
+            s->resize(0.0f, 0.0f, options->w, 0.0f);
+            options->addLeaf(s);
+        }
+        return options;
+    }
+
+    const Table &TableCache::get(Shape in, Shape out, const std::array<cl_float, 10> &geometry, const std::function<Table(void)> &build)
+    {
+        std::array<std::uint32_t, 16> k = {in.depth, in.length, in.width, out.depth, out.length, out.width};
+        auto bits = std::bit_cast<std::array<std::uint32_t, 10>>(geometry);
+        std::copy(bits.begin(), bits.end(), k.begin() + 6);
+
+        if (table.index.empty() || k != key)
+        {
+            table = build();
+            key = k;
+        }
+        return table;
+    }
+
+    ToPolar::ToPolar()
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = []()
+        { return gui::Tree::build("OPTIONS"); };
+        Filter::replicate = [](const opencl::Device &) -> std::shared_ptr<opencl::Filter>
+        { return std::make_shared<ToPolar>(); };
+    }
+
+    void ToPolar::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        if (!accept(wv))
+            return;
+
+        auto dims = opencl::ToPolar::outputShape(*source);
+        volume->depth = dims[0];
+        volume->length = dims[1];
+        volume->width = dims[2];
+    }
+
+    void ToPolar::execute()
+    {
+        if (!source)
+            return;
+
+        Shape o = {volume->depth, volume->length, volume->width};
+        const Table &t = cache.get(shape, o, {volume->ratio, volume->delta}, [&]()
+                                   { return sphericalTable(shape, o, volume->ratio, volume->delta); });
+        scanConvert(shape, in(), o, out(), t);
+    }
+
+    ToCartesian::ToCartesian()
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::replicate = [this](const opencl::Device &) -> std::shared_ptr<opencl::Filter>
+        {
+            auto f = std::make_shared<ToCartesian>();
+            f->spacingSlider = spacingSlider;
+            return f;
+        };
+
+        spacingSlider = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+        spacingSlider->value = 1.0f / 3.0f;
+    }
+
+    void ToCartesian::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        if (!accept(wv))
+            return;
+
+        std::array<cl_uint, 3> dims = {shape.depth, shape.length, shape.width};
+        bool physical = opencl::ToCartesian::fanGrid(*source, spacingSlider->value, dims, grid);
+        range = physical ? source->pointRange : std::array<cl_float, 2>{0.0f, 0.0f};
+        lines = physical ? source->lineRange : std::array<cl_float, 2>{0.0f, 0.0f};
+        volume->depth = dims[0];
+        volume->length = dims[1];
+        volume->width = dims[2];
+        volume->pointRange = {0.0f, 0.0f};
+        volume->lineRange = {0.0f, 0.0f};
+    }
+
+    void ToCartesian::execute()
+    {
+        if (!source)
+            return;
+
+        Shape o = {volume->depth, volume->length, volume->width};
+        bool physical = range[1] > range[0];
+        const Table &t = cache.get(shape, o, {volume->ratio, volume->delta, grid[0], grid[1], grid[2], grid[3], range[0], range[1], lines[0], lines[1]}, [&]()
+                                   { return physical ? fanTable(shape, o, volume->delta, grid, range, lines) : cartesianTable(shape, o, volume->ratio, volume->delta); });
+        scanConvert(shape, in(), o, out(), t);
+    }
+
+    std::shared_ptr<gui::Tree> ToCartesian::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+        spacingSlider->resize(0.0f, 0.0f, options->w, 0.0f);
+        options->addLeaf(spacingSlider);
+        return options;
+    }
+
+    std::vector<std::pair<std::string, std::shared_ptr<opencl::Filter>>> filters()
+    {
+        auto slider = [](float value)
+        {
+            auto s = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+            s->value = value;
+            return s;
+        };
+        auto pointwise = [](void (*f)(const frame_t &, frame_t &))
+        {
+            return std::make_shared<Pass>([f](Shape, const frame_t &i, frame_t &o, data::Volume &)
+                                          { f(i, o); });
+        };
+
+        // Radius 0 to 16 per axis and the threshold's bias over the mean, as in opencl::Box.
+        auto box = [&slider](cl_uint statistic)
+        {
+            std::vector<std::shared_ptr<gui::Slider>> s = {slider(0.125f), slider(0.125f), slider(0.125f)};
+            if (statistic == 2)
+                s.push_back(slider(0.5f));
+            return std::make_shared<Pass>([s, statistic](Shape shape, const frame_t &i, frame_t &o, data::Volume &)
+                                          {
+                                              std::array<cl_uint, 3> r;
+                                              for (std::size_t a = 0; a < r.size(); ++a)
+                                                  r[a] = static_cast<cl_uint>(std::lround(s[a]->value * 16.0f));
+                                              if (shape.width == 1)
+                                                  r[2] = 0;
+                                              boxStatistics(shape, i, o, r, statistic, statistic == 2 ? (s[3]->value - 0.5f) * 128.0f : 0.0f); }, s);
+        };
+
+        std::vector<std::shared_ptr<gui::Slider>> slices = {slider(0.0f), slider(0.0f), slider(0.0f)};
+        std::vector<std::shared_ptr<gui::Slider>> bounds = {slider(0.0f), slider(0.0f), slider(0.0f), slider(0.0f), slider(0.0f), slider(0.0f)};
+        std::vector<std::shared_ptr<gui::Slider>> colour = {slider(0.0f), slider(0.0f), slider(0.0f)};
+        auto level = slider(0.0f);
+        auto radius = slider(0.0f);
+        auto sigma = slider(0.15f);
+
+        return {
+            {"To Polar", std::make_shared<ToPolar>()},
+            {"To Cartesian", std::make_shared<ToCartesian>()},
+            {"Slice", std::make_shared<Pass>([slices](Shape s, const frame_t &i, frame_t &o, data::Volume &)
+                                             { slice(s, i, o, {slices[0]->value, slices[1]->value, slices[2]->value}); }, slices)},
+            {"Threshold", std::make_shared<Pass>([level](Shape, const frame_t &i, frame_t &o, data::Volume &)
+                                                 { threshold(i, o, static_cast<cl_uchar>(level->value * 255.0f)); }, std::vector{level})},
+            {"Invert", std::make_shared<Pass>([](Shape, const frame_t &i, frame_t &o, data::Volume &v)
+                                              {
+                                                  invert(i, o);
+                                                  cl_uchar minim = v.min;
+                                                  v.min = static_cast<cl_uchar>(0xFF - v.max);
+                                                  v.max = static_cast<cl_uchar>(0xFF - minim); })},
+            {"Clamp", std::make_shared<Pass>([bounds](Shape s, const frame_t &i, frame_t &o, data::Volume &)
+                                             { clamping(s, i, o, {bounds[0]->value, bounds[1]->value, bounds[2]->value, bounds[3]->value, bounds[4]->value, bounds[5]->value}); }, bounds)},
+            {"Contrast", std::make_shared<Pass>([](Shape, const frame_t &i, frame_t &o, data::Volume &v)
+                                                {
+                                                    contrast(i, o, v.min, v.max);
+                                                    v.min = 0; })},
+            {"Log2", std::make_shared<Pass>([](Shape, const frame_t &i, frame_t &o, data::Volume &v)
+                                            {
+                                                logTwo(i, o);
+                                                v.min = static_cast<cl_uchar>(std::log2(v.min));
+                                                v.max = static_cast<cl_uchar>(std::log2(v.max)); })},
+            {"Shrink", std::make_shared<Pass>([](Shape s, const frame_t &i, frame_t &o, data::Volume &)
+                                              { shrink(s, i, o); })},
+            {"Fade", pointwise(fade)},
+            {"Sqrt", pointwise(square)},
+            {"Colourise", std::make_shared<Pass>([colour](Shape, const frame_t &i, frame_t &o, data::Volume &)
+                                                 { colourise(i, o, colour[0]->value, colour[1]->value, colour[2]->value); }, colour)},
+            {"Median", std::make_shared<Pass>([radius](Shape s, const frame_t &i, frame_t &o, data::Volume &)
+                                              { median(s, i, o, 1 + static_cast<cl_uint>(std::lround(radius->value * 4.0f))); }, std::vector{radius})},
+            {"Gaussian", std::make_shared<Pass>([sigma](Shape s, const frame_t &i, frame_t &o, data::Volume &)
+                                                {
+                                                    cl_float4 c = opencl::Gaussian::coefficients(opencl::Gaussian::sigma(sigma->value));
+                                                    gaussian(s, i, o, {c.s[0], c.s[1], c.s[2], c.s[3]}); }, std::vector{sigma})},
+            {"Morphology", std::make_shared<Morphology>()},
+            {"Box Mean", box(0)},
+            {"Box Variance", box(1)},
+            {"Adaptive Threshold", box(2)}};
+    }
+
+} // namespace native
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef NATIVE_FILTERS_HH
+#define NATIVE_FILTERS_HH
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Filter.hh"
+#include "Kernels.hh"
+
+#include "../Data/Volume.hh"
+#include "../GUI/Tree.hh"
+#include "../GUI/Slider.hh"
+#include "../OpenCL/Kernels/Morphology.hh"
+
+namespace native
+{
+
+    // Host versions of the OpenCL filters. Replicas share their options, like the OpenCL ones do.
+
+    // One kernel call per frame, op also adjusts the output's min and max where the OpenCL filter does.
+    class Pass : public Filter
+    {
+    public:
+        using op_t = std::function<void(Shape, const frame_t &, frame_t &, data::Volume &)>;
+
+    private:
+        op_t op;
+        std::vector<std::shared_ptr<gui::Slider>> sliders;
+
+    public:
+        Pass(const op_t &o, const std::vector<std::shared_ptr<gui::Slider>> &s = {});
+        ~Pass() = default;
+
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+    class Morphology : public Filter
+    {
+    private:
+        using Operation = opencl::Morphology::Operation;
+
+        std::shared_ptr<Operation> operation;
+        std::array<std::shared_ptr<gui::Slider>, 3> sliders;
+
+        void pass(std::vector<cl_uchar> &alpha, bool dilate);
+
+    public:
+        Morphology();
+        ~Morphology() = default;
+
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+    // Last scan-conversion table, floats keyed by their bits like opencl::ScanTable.
+    struct TableCache
+    {
+        std::array<std::uint32_t, 16> key = {};
+        Table table;
+
+        const Table &get(Shape in, Shape out, const std::array<cl_float, 10> &geometry, const std::function<Table(void)> &build);
+    };
+
+    class ToPolar : public Filter
+    {
+    private:
+        TableCache cache;
+
+    public:
+        ToPolar();
+        ~ToPolar() = default;
+
+        void input(const std::weak_ptr<data::Volume> &wv);
+        void execute();
+    };
+
+    class ToCartesian : public Filter
+    {
+    private:
+        TableCache cache;
+        std::shared_ptr<gui::Slider> spacingSlider;
+        std::array<cl_float, 4> grid = {};
+        std::array<cl_float, 2> range = {};
+        std::array<cl_float, 2> lines = {};
+
+    public:
+        ToCartesian();
+        ~ToCartesian() = default;
+
+        void input(const std::weak_ptr<data::Volume> &wv);
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+    // Every host filter under the name main gives its OpenCL counterpart.
+    std::vector<std::pair<std::string, std::shared_ptr<opencl::Filter>>> filters();
+
+} // namespace native
+
+#endif
\ No newline at end of file
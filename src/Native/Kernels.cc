@@ -0,0 +1,749 @@
+#include "Kernels.hh"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "Pool.hh"
+
+namespace
+{
+    using native::Shape;
+
+    // OpenCL's mix, a + (b - a) * t, glm::mix rounds differently.
+    template <typename T>
+    T mix(T a, T b, float t)
+    {
+        return a + (b - a) * t;
+    }
+
+    // convert_uchar_sat_rte
+    cl_uchar satRte(float v)
+    {
+        return static_cast<cl_uchar>(std::fmin(std::fmax(std::nearbyint(v), 0.0f), 255.0f));
+    }
+
+    // convert_uchar_sat, truncating, NaN goes to 0
+    cl_uchar sat(float v)
+    {
+        return v > 0.0f ? static_cast<cl_uchar>(std::fmin(v, 255.0f)) : 0;
+    }
+
+    // convert_uint_sat
+    cl_uint satUint(float v)
+    {
+        return v > 0.0f ? (v < 4294967040.0f ? static_cast<cl_uint>(v) : std::numeric_limits<cl_uint>::max()) : 0;
+    }
+
+    glm::vec4 toFloat(cl_uchar4 c)
+    {
+        return {c.s[0], c.s[1], c.s[2], c.s[3]};
+    }
+
+    // Runs f(i) for every index of [0, n) on the pool.
+    template <typename F>
+    void forEach(std::size_t n, F f)
+    {
+        native::Pool::shared().parallelFor(
+            n, [&](std::size_t b, std::size_t e)
+            {
+                for (std::size_t i = b; i < e; ++i)
+                    f(i); });
+    }
+
+    // Runs f(b, e) for chunks of [0, n) on the pool, for loops that take several voxels per step.
+    template <typename F>
+    void forRange(std::size_t n, F f)
+    {
+        native::Pool::shared().parallelFor(n, [&](std::size_t b, std::size_t e)
+                                           { f(b, e); });
+    }
+
+    // Result of a pointwise alpha function for every alpha value, the lookup gives the same bytes as
+    // evaluating f per voxel.
+    template <typename F>
+    std::array<cl_uchar, 256> alphaTable(F f)
+    {
+        std::array<cl_uchar, 256> table;
+        for (std::size_t a = 0; a < table.size(); ++a)
+            table[a] = f(static_cast<float>(a));
+        return table;
+    }
+
+    void mapAlpha(const native::frame_t &input, native::frame_t &output, const std::array<cl_uchar, 256> &table)
+    {
+        forEach(input.size(), [&](std::size_t i)
+                {
+                    output[i] = input[i];
+                    output[i].s[3] = table[input[i].s[3]]; });
+    }
+
+#ifdef __SSE2__
+    // Four voxels per register, alpha is the high byte of each 32 bit lane.
+    __m128i load(const native::frame_t &frame, std::size_t i)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(&frame[i]));
+    }
+
+    void store(native::frame_t &frame, std::size_t i, __m128i v)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&frame[i]), v);
+    }
+#endif
+
+    // Runs f(x, y, z, i) for every voxel of s, a depth line per step so the inner loop stays contiguous.
+    template <typename F>
+    void forEachVoxel(Shape s, F f)
+    {
+        native::Pool::shared().parallelFor(
+            static_cast<std::size_t>(s.length) * s.width, [&](std::size_t b, std::size_t e)
+            {
+                for (std::size_t l = b; l < e; ++l)
+                {
+                    cl_uint y = static_cast<cl_uint>(l % s.length);
+                    cl_uint z = static_cast<cl_uint>(l / s.length);
+                    std::size_t i = l * s.depth;
+                    for (cl_uint x = 0; x < s.depth; ++x, ++i)
+                        f(x, y, z, i);
+                } },
+            std::max<std::size_t>(1, 4096 / std::max(s.depth, 1u)));
+    }
+
+    // Lines along axis (0 depth, 1 length, 2 width): f(first voxel, stride, count) for every line of s.
+    template <typename F>
+    void forEachLine(Shape s, cl_uint axis, F f)
+    {
+        const std::array<cl_uint, 3> dims = {s.depth, s.length, s.width};
+        const std::array<std::size_t, 3> strides = {1, s.depth, static_cast<std::size_t>(s.depth) * s.length};
+        cl_uint a = axis == 0 ? 1 : 0;
+        cl_uint b = axis == 2 ? 1 : 2;
+
+        native::Pool::shared().parallelFor(
+            static_cast<std::size_t>(dims[a]) * dims[b], [&](std::size_t lo, std::size_t hi)
+            {
+                for (std::size_t l = lo; l < hi; ++l)
+                    f((l % dims[a]) * strides[a] + (l / dims[a]) * strides[b], strides[axis], dims[axis]); },
+            std::max<std::size_t>(1, 4096 / std::max(dims[axis], 1u)));
+    }
+
+    void tableEntry(glm::vec3 p, bool inside, Shape in, native::Table &table, std::size_t i)
+    {
+        glm::vec3 hi(static_cast<float>(in.depth) - 1.0f, static_cast<float>(in.length) - 1.0f, static_cast<float>(in.width) - 1.0f);
+        p = glm::clamp(p, glm::vec3(0.0f), hi);
+
+        glm::vec3 corner = glm::min(glm::floor(p), glm::max(hi - 1.0f, glm::vec3(0.0f)));
+        glm::uvec3 c(corner);
+        glm::vec3 f = p - corner;
+
+        table.index[i] = c.x + c.y * in.depth + c.z * in.depth * in.length;
+        table.weight[i] = inside ? cl_uchar4{{satRte(f.x * 255.0f), satRte(f.y * 255.0f), satRte(f.z * 255.0f), 0xFF}} : cl_uchar4{{0, 0, 0, 0}};
+    }
+
+    native::Table table(Shape out)
+    {
+        return {std::vector<cl_uint>(out.voxels()), std::vector<cl_uchar4>(out.voxels())};
+    }
+
+    bool rayHitBBox(glm::vec3 org, glm::vec3 dir, float &nPlane, float &fPlane)
+    {
+        glm::vec3 invRay = 1.0f / dir;
+        glm::vec3 posInts = invRay * (glm::vec3(1.0f) - org);
+        glm::vec3 negInts = invRay * (glm::vec3(-1.0f) - org);
+
+        glm::vec3 maxInts = glm::max(posInts, negInts);
+        glm::vec3 minInts = glm::min(posInts, negInts);
+
+        fPlane = glm::min(glm::min(maxInts.x, maxInts.y), glm::min(maxInts.x, maxInts.z));
+        nPlane = glm::max(glm::max(minInts.x, minInts.y), glm::max(minInts.x, minInts.z));
+        return fPlane > nPlane;
+    }
+
+    void eyeRay(cl_uint x, cl_uint y, cl_uint wOut, cl_uint lOut, const std::array<float, 12> &inv, glm::vec3 &org, glm::vec3 &dir)
+    {
+        float u = (static_cast<float>(x) / static_cast<float>(wOut)) * 2.0f - 1.0f;
+        float v = (static_cast<float>(y) / static_cast<float>(lOut)) * 2.0f - 1.0f;
+
+        org = {inv[3], inv[7], inv[11]};
+
+        glm::vec4 acc = glm::normalize(glm::vec4(u, v, -2.0f, 0.0f));
+        dir = {
+            glm::dot(acc, glm::vec4(inv[0], inv[1], inv[2], inv[3])),
+            glm::dot(acc, glm::vec4(inv[4], inv[5], inv[6], inv[7])),
+            glm::dot(acc, glm::vec4(inv[8], inv[9], inv[10], inv[11]))};
+    }
+
+    cl_uint packPixel(glm::vec4 acc)
+    {
+        acc *= 255.0f;
+        return (cl_uint(sat(acc.x)) << 24) | (cl_uint(sat(acc.y)) << 16) | (cl_uint(sat(acc.z)) << 8) | cl_uint(sat(acc.w));
+    }
+
+    // Ray loop shared by render and renderPolar, sample(pos, value) returns false to skip a step.
+    template <typename Sample>
+    cl_uint march(cl_uint x, cl_uint y, cl_uint wOut, cl_uint lOut, Shape s, const std::array<float, 12> &inv, Sample sample)
+    {
+        glm::vec3 org, dir;
+        eyeRay(x, y, wOut, lOut, inv, org, dir);
+
+        float nPlane, fPlane;
+        if (!rayHitBBox(org, dir, nPlane, fPlane))
+            return 0;
+
+        nPlane = std::fabs(nPlane);
+
+        glm::vec4 acc(1.0f, 1.0f, 1.0f, 0.0f);
+        float t = fPlane;
+
+        cl_uint stepLim = static_cast<cl_uint>(std::sqrt(static_cast<float>(s.depth * s.depth + s.length * s.length + s.width * s.width + 1))) / 4;
+        float td = (fPlane - nPlane) / static_cast<float>(stepLim);
+        for (cl_uint i = 0; i < stepLim; ++i)
+        {
+            glm::vec3 pos = org + dir * t;
+            t -= td;
+
+            cl_uchar4 v;
+            if (!sample(pos, v) || (v.s[0] | v.s[1] | v.s[2] | v.s[3]) == 0)
+                continue;
+
+            glm::vec4 sampleF = toFloat(v) / 255.0f;
+            acc = mix(acc, sampleF, sampleF.w);
+
+            if (t < nPlane)
+                break;
+        }
+
+        return packPixel(acc);
+    }
+}
+
+namespace native
+{
+
+    void slice(Shape s, const frame_t &input, frame_t &output, const std::array<cl_float, 3> &slices)
+    {
+        forEachVoxel(s, [&](cl_uint x, cl_uint y, cl_uint z, std::size_t i)
+                     {
+                         bool keep = std::fabs(static_cast<float>(x) - slices[0] * static_cast<float>(s.depth)) < 3.0f ||
+                                     std::fabs(static_cast<float>(y) - slices[1] * static_cast<float>(s.length)) < 3.0f ||
+                                     std::fabs(static_cast<float>(z) - slices[2] * static_cast<float>(s.width)) < 3.0f;
+                         output[i] = keep ? input[i] : cl_uchar4{{0, 0, 0, 0}}; });
+    }
+
+    void clamping(Shape s, const frame_t &input, frame_t &output, const std::array<cl_float, 6> &bounds)
+    {
+        std::array<float, 3> dims = {static_cast<float>(s.depth), static_cast<float>(s.length), static_cast<float>(s.width)};
+        forEachVoxel(s, [&](cl_uint x, cl_uint y, cl_uint z, std::size_t i)
+                     {
+                         std::array<float, 3> p = {static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)};
+                         bool keep = true;
+                         for (std::size_t a = 0; a < 3; ++a)
+                             keep = keep && p[a] > bounds[2 * a] * dims[a] && p[a] < bounds[2 * a + 1] * dims[a];
+                         output[i] = keep ? input[i] : cl_uchar4{{0, 0, 0, 0}}; });
+    }
+
+    void threshold(const frame_t &input, frame_t &output, cl_uchar val)
+    {
+        forRange(input.size(), [&](std::size_t b, std::size_t e)
+                 {
+                     std::size_t i = b;
+#ifdef __SSE2__
+                     const __m128i limit = _mm_set1_epi32(val);
+                     for (; i + 4 <= e; i += 4)
+                     {
+                         __m128i v = load(input, i);
+                         store(output, i, _mm_and_si128(v, _mm_cmpgt_epi32(_mm_srli_epi32(v, 24), limit)));
+                     }
+#endif
+                     for (; i < e; ++i)
+                         output[i] = input[i].s[3] > val ? input[i] : cl_uchar4{{0, 0, 0, 0}}; });
+    }
+
+    void invert(const frame_t &input, frame_t &output)
+    {
+        forRange(input.size(), [&](std::size_t b, std::size_t e)
+                 {
+                     std::size_t i = b;
+#ifdef __SSE2__
+                     const __m128i ones = _mm_set1_epi32(-1);
+                     const __m128i floor = _mm_set1_epi32(0x01000000); // Alpha stays at least 1
+                     for (; i + 4 <= e; i += 4)
+                         store(output, i, _mm_max_epu8(_mm_xor_si128(load(input, i), ones), floor));
+#endif
+                     for (; i < e; ++i)
+                     {
+                         const cl_uchar4 &v = input[i];
+                         output[i] = {{static_cast<cl_uchar>(0xFF - v.s[0]), static_cast<cl_uchar>(0xFF - v.s[1]), static_cast<cl_uchar>(0xFF - v.s[2]), static_cast<cl_uchar>(std::max(0xFF - v.s[3], 0x01))}};
+                     } });
+    }
+
+    void contrast(const frame_t &input, frame_t &output, cl_uchar minim, cl_uchar maxim)
+    {
+        float mdiff = static_cast<float>(maxim - minim);
+        mapAlpha(input, output, alphaTable([&](float a)
+                                           { return static_cast<cl_uchar>(std::fmin(std::fmax((a - static_cast<float>(minim)) / mdiff * 255.0f, 0.0f), 255.0f)); }));
+    }
+
+    void logTwo(const frame_t &input, frame_t &output)
+    {
+        mapAlpha(input, output, alphaTable([](float a)
+                                           { return static_cast<cl_uchar>(std::log2(1.0f + a / 255.0f) * 255.0f); }));
+    }
+
+    void square(const frame_t &input, frame_t &output)
+    {
+        mapAlpha(input, output, alphaTable([](float a)
+                                           { return static_cast<cl_uchar>(std::sqrt(a / 255.0f) * 255.0f); }));
+    }
+
+    void shrink(Shape s, const frame_t &input, frame_t &output)
+    {
+        const int r = 3;
+        forEachVoxel(s, [&](cl_uint x, cl_uint y, cl_uint z, std::size_t i)
+                     {
+                         auto at = [&](int dx, int dy, int dz)
+                         {
+                             std::size_t xx = static_cast<std::size_t>(std::clamp(static_cast<int>(x) + dx, 0, static_cast<int>(s.depth) - 1));
+                             std::size_t yy = static_cast<std::size_t>(std::clamp(static_cast<int>(y) + dy, 0, static_cast<int>(s.length) - 1));
+                             std::size_t zz = static_cast<std::size_t>(std::clamp(static_cast<int>(z) + dz, 0, static_cast<int>(s.width) - 1));
+                             return input[xx + yy * s.depth + zz * s.depth * s.length].s[3];
+                         };
+
+                         output[i] = input[i];
+                         for (int d = 1; d <= r; ++d)
+                         {
+                             if (at(-d, 0, 0) == 0 || at(d, 0, 0) == 0 || at(0, -d, 0) == 0 || at(0, d, 0) == 0 || at(0, 0, -d) == 0 || at(0, 0, d) == 0)
+                             {
+                                 output[i].s[3] = 0x00;
+                                 break;
+                             }
+                         } });
+    }
+
+    void fade(const frame_t &input, frame_t &output)
+    {
+        forRange(input.size(), [&](std::size_t b, std::size_t e)
+                 {
+                     std::size_t i = b;
+#ifdef __SSE2__
+                     const __m128i rgb = _mm_set1_epi32(0x00FFFFFF);
+                     const __m128i pair = _mm_set1_epi32(0xFFFF);
+                     for (; i + 4 <= e; i += 4)
+                     {
+                         __m128i v = load(input, i);
+                         // r ^ g and g ^ b in the two low bytes, both zero for grey voxels
+                         __m128i grey = _mm_cmpeq_epi32(_mm_and_si128(_mm_xor_si128(v, _mm_srli_epi32(v, 8)), pair), _mm_setzero_si128());
+                         __m128i halved = _mm_or_si128(_mm_and_si128(v, rgb), _mm_slli_epi32(_mm_srli_epi32(v, 25), 24));
+                         store(output, i, _mm_or_si128(_mm_and_si128(grey, halved), _mm_andnot_si128(grey, v)));
+                     }
+#endif
+                     for (; i < e; ++i)
+                     {
+                         output[i] = input[i];
+                         if (input[i].s[0] == input[i].s[1] && input[i].s[0] == input[i].s[2]) // Not Doppler data
+                             output[i].s[3] = static_cast<cl_uchar>(input[i].s[3] / 2);
+                     } });
+    }
+
+    void colourise(const frame_t &input, frame_t &output, cl_float red, cl_float green, cl_float blue)
+    {
+        const std::array<float, 3> colour = {red, green, blue};
+        forRange(input.size(), [&](std::size_t b, std::size_t e)
+                 {
+                     std::size_t i = b;
+#ifdef __SSE2__
+                     // One voxel per register, the same operations in the same order as the scalar loop.
+                     const __m128 tint = _mm_setr_ps(red, green, blue, 0.0f);
+                     const __m128 scale = _mm_set1_ps(255.0f);
+                     const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+                     const __m128i zero = _mm_setzero_si128();
+                     auto shade = [&](__m128i c)
+                     {
+                         __m128 f = _mm_div_ps(_mm_cvtepi32_ps(c), scale);
+                         __m128 a = _mm_shuffle_ps(f, f, _MM_SHUFFLE(3, 3, 3, 3));
+                         return _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(tint, _mm_mul_ps(_mm_sub_ps(f, tint), a)), scale));
+                     };
+                     for (; i + 4 <= e; i += 4)
+                     {
+                         __m128i v = load(input, i);
+                         __m128i lo = _mm_unpacklo_epi8(v, zero);
+                         __m128i hi = _mm_unpackhi_epi8(v, zero);
+                         __m128i first = _mm_packs_epi32(shade(_mm_unpacklo_epi16(lo, zero)), shade(_mm_unpackhi_epi16(lo, zero)));
+                         __m128i second = _mm_packs_epi32(shade(_mm_unpacklo_epi16(hi, zero)), shade(_mm_unpackhi_epi16(hi, zero)));
+                         store(output, i, _mm_or_si128(_mm_andnot_si128(alpha, _mm_packus_epi16(first, second)), _mm_and_si128(alpha, v)));
+                     }
+#endif
+                     for (; i < e; ++i)
+                     {
+                         output[i] = input[i];
+                         float a = static_cast<float>(input[i].s[3]) / 255.0f;
+                         for (std::size_t c = 0; c < 3; ++c)
+                             output[i].s[c] = static_cast<cl_uchar>(mix(colour[c], static_cast<float>(input[i].s[c]) / 255.0f, a) * 255.0f);
+                     } });
+    }
+
+    // medianHistogram for every radius, the selection network gives the same (exact) median.
+    void median(Shape s, const frame_t &input, frame_t &output, cl_uint radius)
+    {
+        int r = static_cast<int>(radius);
+        int rz = s.width == 1 ? 0 : r;
+        int rank = (2 * r + 1) * (2 * r + 1) * (2 * rz + 1) / 2;
+
+        Pool::shared().parallelFor(
+            static_cast<std::size_t>(s.length) * s.width, [&](std::size_t b, std::size_t e)
+            {
+                for (std::size_t l = b; l < e; ++l)
+                {
+                    int y = static_cast<int>(l % s.length);
+                    int z = static_cast<int>(l / s.length);
+
+                    std::array<int, 256> hist{};
+                    cl_uchar m = 0;
+                    int below = 0;
+
+                    auto plane = [&](int x, int sign)
+                    {
+                        x = std::clamp(x, 0, static_cast<int>(s.depth) - 1);
+                        for (int dz = -rz; dz <= rz; ++dz)
+                        {
+                            std::size_t zz = static_cast<std::size_t>(std::clamp(z + dz, 0, static_cast<int>(s.width) - 1));
+                            for (int dy = -r; dy <= r; ++dy)
+                            {
+                                std::size_t yy = static_cast<std::size_t>(std::clamp(y + dy, 0, static_cast<int>(s.length) - 1));
+                                cl_uchar v = input[static_cast<std::size_t>(x) + yy * s.depth + zz * s.depth * s.length].s[3];
+                                hist[v] += sign;
+                                below += v < m ? sign : 0;
+                            }
+                        }
+                    };
+
+                    for (int dx = -r; dx <= r; ++dx)
+                        plane(dx, 1);
+
+                    for (int x = 0; x < static_cast<int>(s.depth); ++x)
+                    {
+                        if (x > 0)
+                        {
+                            plane(x - r - 1, -1);
+                            plane(x + r, 1);
+                        }
+
+                        while (below > rank)
+                        {
+                            --m;
+                            below -= hist[m];
+                        }
+                        while (below + hist[m] <= rank)
+                        {
+                            below += hist[m];
+                            ++m;
+                        }
+
+                        // The kernels store the scalar, which broadcasts to every channel
+                        output[static_cast<std::size_t>(x) + l * s.depth] = {{m, m, m, m}};
+                    }
+                } },
+            1);
+    }
+
+    // alphaToFloat, gaussianIIR per axis and floatToAlpha, c = (B, b1/b0, b2/b0, b3/b0).
+    void gaussian(Shape s, const frame_t &input, frame_t &output, const std::array<cl_float, 4> &c)
+    {
+        std::vector<float> alpha(input.size());
+        forEach(input.size(), [&](std::size_t i)
+                { alpha[i] = static_cast<float>(input[i].s[3]); });
+
+        for (cl_uint axis = 0; axis < (s.width == 1 ? 2u : 3u); ++axis)
+        {
+            forEachLine(s, axis, [&](std::size_t start, std::size_t stride, cl_uint n)
+                        {
+                            float *line = alpha.data() + start;
+
+                            float w1 = line[0], w2 = w1, w3 = w1;
+                            for (std::size_t i = 0; i < n; ++i)
+                            {
+                                float w = c[0] * line[i * stride] + c[1] * w1 + c[2] * w2 + c[3] * w3;
+                                line[i * stride] = w;
+                                w3 = w2;
+                                w2 = w1;
+                                w1 = w;
+                            }
+
+                            float y1 = line[(n - 1) * stride], y2 = y1, y3 = y1;
+                            for (std::size_t i = n; i-- > 0;)
+                            {
+                                float v = c[0] * line[i * stride] + c[1] * y1 + c[2] * y2 + c[3] * y3;
+                                line[i * stride] = v;
+                                y3 = y2;
+                                y2 = y1;
+                                y1 = v;
+                            } });
+        }
+
+        forEach(input.size(), [&](std::size_t i)
+                {
+                    output[i] = input[i];
+                    output[i].s[3] = satRte(alpha[i]); });
+    }
+
+    // van Herk/Gil-Werman in place, each line is copied out (extended by r replicated voxels) first.
+    void morphologyLine(Shape s, std::vector<cl_uchar> &alpha, cl_uint axis, cl_uint radius, bool dilate)
+    {
+        auto pick = [dilate](cl_uchar a, cl_uchar b)
+        { return dilate ? std::max(a, b) : std::min(a, b); };
+
+        forEachLine(s, axis, [&](std::size_t start, std::size_t stride, cl_uint n)
+                    {
+                        std::size_t k = 2 * radius + 1;
+                        std::size_t ext = n + 2 * radius;
+                        std::vector<cl_uchar> line(ext), h(ext);
+                        for (std::size_t j = 0; j < ext; ++j)
+                            line[j] = alpha[start + static_cast<std::size_t>(std::clamp(static_cast<long>(j) - static_cast<long>(radius), 0l, static_cast<long>(n) - 1)) * stride];
+
+                        for (std::size_t j = ext; j-- > 0;)
+                            h[j] = ((j + 1) % k == 0 || j + 1 == ext) ? line[j] : pick(line[j], h[j + 1]);
+
+                        cl_uchar g = 0;
+                        for (std::size_t j = 0; j < ext; ++j)
+                        {
+                            g = j % k == 0 ? line[j] : pick(g, line[j]);
+                            if (j >= 2 * radius)
+                            {
+                                std::size_t x = j - 2 * radius;
+                                alpha[start + x * stride] = pick(h[x], g);
+                            }
+                        } });
+    }
+
+    // integralLine over every axis, then boxStatistics. Unsigned sums wrap the same way as on the device.
+    void boxStatistics(Shape s, const frame_t &input, frame_t &output, const std::array<cl_uint, 3> &radius, cl_uint statistic, cl_float bias)
+    {
+        std::vector<cl_uint> sum(input.size());
+        std::vector<cl_ulong> squares(input.size());
+        forEach(input.size(), [&](std::size_t i)
+                {
+                    cl_uint v = input[i].s[3];
+                    sum[i] = v;
+                    squares[i] = v * v; });
+
+        for (cl_uint axis = 0; axis < (s.width == 1 ? 2u : 3u); ++axis)
+        {
+            forEachLine(s, axis, [&](std::size_t start, std::size_t stride, cl_uint n)
+                        {
+                            for (std::size_t i = 1; i < n; ++i)
+                            {
+                                sum[start + i * stride] += sum[start + (i - 1) * stride];
+                                squares[start + i * stride] += squares[start + (i - 1) * stride];
+                            } });
+        }
+
+        const std::array<std::ptrdiff_t, 3> dims = {static_cast<std::ptrdiff_t>(s.depth), static_cast<std::ptrdiff_t>(s.length), static_cast<std::ptrdiff_t>(s.width)};
+        forEachVoxel(s, [&](cl_uint x, cl_uint y, cl_uint z, std::size_t i)
+                     {
+                         const std::array<std::ptrdiff_t, 3> p = {static_cast<std::ptrdiff_t>(x), static_cast<std::ptrdiff_t>(y), static_cast<std::ptrdiff_t>(z)};
+                         std::array<std::ptrdiff_t, 3> lo, hi;
+                         for (std::size_t a = 0; a < 3; ++a)
+                         {
+                             lo[a] = std::max<std::ptrdiff_t>(p[a] - static_cast<std::ptrdiff_t>(radius[a]), 0) - 1;
+                             hi[a] = std::min<std::ptrdiff_t>(p[a] + static_cast<std::ptrdiff_t>(radius[a]), dims[a] - 1);
+                         }
+
+                         cl_uint total = 0;
+                         cl_ulong q = 0;
+                         for (int c = 0; c < 8; ++c)
+                         {
+                             std::ptrdiff_t kx = c & 1 ? lo[0] : hi[0], ky = c & 2 ? lo[1] : hi[1], kz = c & 4 ? lo[2] : hi[2];
+                             if (kx < 0 || ky < 0 || kz < 0)
+                                 continue;
+
+                             std::size_t k = static_cast<std::size_t>(kx + ky * dims[0] + kz * dims[0] * dims[1]);
+                             if (std::popcount(static_cast<unsigned>(c)) & 1)
+                             {
+                                 total -= sum[k];
+                                 q -= squares[k];
+                             }
+                             else
+                             {
+                                 total += sum[k];
+                                 q += squares[k];
+                             }
+                         }
+
+                         cl_ulong n = static_cast<cl_ulong>((hi[0] - lo[0]) * (hi[1] - lo[1]) * (hi[2] - lo[2]));
+                         float mean = static_cast<float>(total) / static_cast<float>(n);
+
+                         output[i] = input[i];
+                         if (statistic == 0)
+                             output[i].s[3] = satRte(mean);
+                         else if (statistic == 1)
+                             output[i].s[3] = satRte(static_cast<float>(n * q - static_cast<cl_ulong>(total) * total) / static_cast<float>(n * n) / 64.0f);
+                         else if (static_cast<float>(input[i].s[3]) <= mean + bias)
+                             output[i] = {{0, 0, 0, 0}}; });
+    }
+
+    Table sphericalTable(Shape in, Shape out, cl_float ratio, cl_float angleDelta)
+    {
+        Table t = table(out);
+
+        float r = static_cast<float>(in.depth) * ratio;
+        float halfAngle = angleDelta / 2.0f;
+        float voff = r + static_cast<float>(in.depth) - static_cast<float>(out.depth);
+        glm::vec3 centrepoint(0.0f, static_cast<float>(out.length) / 2, static_cast<float>(out.width) / 2);
+
+        forEachVoxel(out, [&](cl_uint x, cl_uint y, cl_uint z, std::size_t i)
+                     {
+                         glm::vec3 pos = glm::vec3(static_cast<float>(x) + voff, static_cast<float>(y), static_cast<float>(z)) - centrepoint;
+
+                         float lAngle = std::atan2(pos.y, pos.x);
+                         float wAngle = std::atan2(pos.z, pos.x);
+                         float R = glm::length(pos);
+
+                         bool inside = !(R < r || R > r + static_cast<float>(in.depth) - 1 || std::fabs(lAngle) > halfAngle || std::fabs(wAngle) > halfAngle);
+
+                         glm::vec3 p(
+                             R - r,
+                             (lAngle / halfAngle / 2.0f + 0.5f) * (static_cast<float>(in.length) - 1.0f),
+                             (wAngle / halfAngle / 2.0f + 0.5f) * (static_cast<float>(in.width) - 1.0f));
+
+                         tableEntry(p, inside, in, t, i); });
+        return t;
+    }
+
+    Table cartesianTable(Shape in, Shape out, cl_float ratio, cl_float angleDelta)
+    {
+        Table t = table(out);
+
+        glm::vec3 centrepoint(0.0f, static_cast<float>(out.length) / 2, static_cast<float>(out.width) / 2);
+        float r = static_cast<float>(in.depth) * (ratio / (1.0f + ratio));
+
+        forEachVoxel(out, [&](cl_uint x, cl_uint y, cl_uint z, std::size_t i)
+                     {
+                         glm::vec3 pos = glm::vec3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) - centrepoint;
+
+                         float angleY = pos.y / static_cast<float>(out.length / 2) * angleDelta / 2.0f;
+                         float angleZ = pos.z / static_cast<float>(out.length / 2) * angleDelta / 2.0f;
+
+                         pos.x *= (static_cast<float>(in.depth) - r) / static_cast<float>(out.depth);
+                         pos.y *= static_cast<float>(in.length) / static_cast<float>(out.length);
+                         pos.z *= static_cast<float>(in.width) / static_cast<float>(out.width);
+
+                         float d = r + glm::length(pos);
+                         glm::vec3 p(d * std::cos(angleY), d * std::sin(angleY), d * std::sin(angleZ));
+
+                         tableEntry(p, true, in, t, i); });
+        return t;
+    }
+
+    Table fanTable(Shape in, Shape out, cl_float angleDelta, const std::array<cl_float, 4> &grid, const std::array<cl_float, 2> &range, const std::array<cl_float, 2> &lines)
+    {
+        Table t = table(out);
+
+        float halfAngle = angleDelta / 2.0f;
+
+        forEachVoxel(out, [&](cl_uint x, cl_uint y, cl_uint z, std::size_t i)
+                     {
+                         glm::vec3 pos = glm::vec3(grid[0], grid[1], grid[2]) + glm::vec3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) * grid[3];
+
+                         float lAngle = std::atan2(pos.y, pos.x);
+                         float wAngle = in.width > 1 ? std::atan2(pos.z, pos.x) : 0.0f;
+                         float R = glm::length(pos);
+
+                         bool inside = R >= range[0] && R <= range[1] && lAngle >= lines[0] && lAngle <= lines[1] && std::fabs(wAngle) <= halfAngle;
+
+                         glm::vec3 p(
+                             (R - range[0]) / (range[1] - range[0]) * (static_cast<float>(in.depth) - 1.0f),
+                             (lAngle - lines[0]) / (lines[1] - lines[0]) * (static_cast<float>(in.length) - 1.0f),
+                             (wAngle / halfAngle / 2.0f + 0.5f) * (static_cast<float>(in.width) - 1.0f));
+
+                         tableEntry(p, inside, in, t, i); });
+        return t;
+    }
+
+    void scanConvert(Shape in, const frame_t &input, Shape out, frame_t &output, const Table &table)
+    {
+        // Flat axes (2D volumes) have no neighbour to blend with
+        std::size_t sx = in.depth > 1 ? 1 : 0;
+        std::size_t sy = in.length > 1 ? in.depth : 0;
+        std::size_t sz = in.width > 1 ? static_cast<std::size_t>(in.depth) * in.length : 0;
+
+        forEach(out.voxels(), [&](std::size_t i)
+                {
+                    cl_uchar4 w = table.weight[i];
+                    if (w.s[3] == 0)
+                    {
+                        output[i] = {{0, 0, 0, 0}}; // Inside empty space
+                        return;
+                    }
+
+                    glm::vec3 f = glm::vec3(w.s[0], w.s[1], w.s[2]) / 255.0f;
+                    const cl_uchar4 *c = input.data() + table.index[i];
+
+                    glm::vec4 c00 = mix(toFloat(c[0]), toFloat(c[sx]), f.x);
+                    glm::vec4 c10 = mix(toFloat(c[sy]), toFloat(c[sy + sx]), f.x);
+                    glm::vec4 c01 = mix(toFloat(c[sz]), toFloat(c[sz + sx]), f.x);
+                    glm::vec4 c11 = mix(toFloat(c[sz + sy]), toFloat(c[sz + sy + sx]), f.x);
+
+                    glm::vec4 v = mix(mix(c00, c10, f.y), mix(c01, c11, f.y), f.z);
+                    output[i] = {{satRte(v.x), satRte(v.y), satRte(v.z), satRte(v.w)}}; });
+    }
+
+    void render(cl_uint wOut, cl_uint lOut, std::vector<cl_uint> &output, Shape s, const frame_t &data, const std::array<float, 12> &invMVTransposed)
+    {
+        glm::vec3 scale(s.depth, s.length, s.width);
+        glm::uvec3 hi(s.depth - 1, s.length - 1, s.width - 1);
+
+        auto sample = [&](glm::vec3 pos, cl_uchar4 &v)
+        {
+            pos = (pos * 0.5f + 0.5f) * scale;
+            glm::uvec3 iPos = glm::min(glm::uvec3(satUint(pos.x), satUint(pos.y), satUint(pos.z)), hi);
+            v = data[iPos.x + iPos.y * s.depth + iPos.z * s.length * s.depth];
+            return true;
+        };
+
+        forEach(static_cast<std::size_t>(wOut) * lOut, [&](std::size_t i)
+                { output[i] = march(static_cast<cl_uint>(i % wOut), static_cast<cl_uint>(i / wOut), wOut, lOut, s, invMVTransposed, sample); });
+    }
+
+    void renderPolar(cl_uint wOut, cl_uint lOut, std::vector<cl_uint> &output, Shape s, const frame_t &data, const std::array<float, 12> &invMVTransposed, cl_float ratio, cl_float angleDelta)
+    {
+        // Fan bounding box as in raytracing.cl's makeFan
+        bool is3D = s.width > 1;
+        float halfAngle = angleDelta / 2.0f;
+        float spread = std::tan(halfAngle);
+        float near = static_cast<float>(s.depth) * ratio;
+        float far = near + static_cast<float>(s.depth) - 1.0f;
+        float x0 = near / std::sqrt(1.0f + spread * spread * (is3D ? 2.0f : 1.0f));
+        float halfExtent = std::max(far - x0, 2.0f * far * std::sin(halfAngle)) / 2.0f;
+        glm::vec3 centre((x0 + far) / 2.0f, 0.0f, 0.0f);
+        glm::uvec3 hi(s.depth - 1, s.length - 1, s.width - 1);
+
+        auto sample = [&](glm::vec3 pos, cl_uchar4 &v)
+        {
+            glm::vec3 p = centre + pos * halfExtent;
+            float R = is3D ? glm::length(p) : glm::length(glm::vec2(p));
+            float lAngle = std::atan2(p.y, p.x);
+            float wAngle = is3D ? std::atan2(p.z, p.x) : 0.0f;
+
+            if (R < near || R > far || std::fabs(lAngle) > halfAngle || std::fabs(wAngle) > halfAngle)
+                return false;
+
+            glm::uvec3 iPos = glm::min(glm::uvec3(
+                                           satUint(R - near),
+                                           satUint((lAngle / halfAngle / 2.0f + 0.5f) * (static_cast<float>(s.length) - 1.0f)),
+                                           satUint((wAngle / halfAngle / 2.0f + 0.5f) * (static_cast<float>(s.width) - 1.0f))),
+                                       hi);
+            v = data[iPos.x + iPos.y * s.depth + iPos.z * s.length * s.depth];
+            return true;
+        };
+
+        forEach(static_cast<std::size_t>(wOut) * lOut, [&](std::size_t i)
+                { output[i] = march(static_cast<cl_uint>(i % wOut), static_cast<cl_uint>(i / wOut), wOut, lOut, s, invMVTransposed, sample); });
+    }
+
+} // namespace native
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef NATIVE_KERNELS_HH
+#define NATIVE_KERNELS_HH
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <CL/cl2.hpp>
+
+namespace native
+{
+
+    using frame_t = std::vector<cl_uchar4>;
+
+    struct Shape
+    {
+        cl_uint depth;
+        cl_uint length;
+        cl_uint width;
+
+        std::size_t voxels() const { return static_cast<std::size_t>(depth) * length * width; }
+    };
+
+    // Host ports of utility.cl, same names and arithmetic, one frame at a time over the shared Pool. The
+    // native_ maths of the device builds have no host equivalent, logTwo and square use the exact functions.
+    // Pointwise kernels take four voxels per SSE2 register where the target has it, contrast, logTwo and square
+    // an alpha lookup, both give the bytes of the scalar loop. Native/Kernels_test.cc checks them against OpenCL.
+    void slice(Shape s, const frame_t &input, frame_t &output, const std::array<cl_float, 3> &slices);
+    void clamping(Shape s, const frame_t &input, frame_t &output, const std::array<cl_float, 6> &bounds);
+    void threshold(const frame_t &input, frame_t &output, cl_uchar val);
+    void invert(const frame_t &input, frame_t &output);
+    void contrast(const frame_t &input, frame_t &output, cl_uchar minim, cl_uchar maxim);
+    void logTwo(const frame_t &input, frame_t &output);
+    void square(const frame_t &input, frame_t &output);
+    void shrink(Shape s, const frame_t &input, frame_t &output);
+    void fade(const frame_t &input, frame_t &output);
+    void colourise(const frame_t &input, frame_t &output, cl_float red, cl_float green, cl_float blue);
+    void median(Shape s, const frame_t &input, frame_t &output, cl_uint radius);
+    void gaussian(Shape s, const frame_t &input, frame_t &output, const std::array<cl_float, 4> &c);
+    void morphologyLine(Shape s, std::vector<cl_uchar> &alpha, cl_uint axis, cl_uint radius, bool dilate);
+    void boxStatistics(Shape s, const frame_t &input, frame_t &output, const std::array<cl_uint, 3> &radius, cl_uint statistic, cl_float bias);
+
+    // Host ports of cartesian.cl
+    struct Table
+    {
+        std::vector<cl_uint> index;
+        std::vector<cl_uchar4> weight;
+    };
+
+    Table sphericalTable(Shape in, Shape out, cl_float ratio, cl_float angleDelta);
+    Table cartesianTable(Shape in, Shape out, cl_float ratio, cl_float angleDelta);
+    Table fanTable(Shape in, Shape out, cl_float angleDelta, const std::array<cl_float, 4> &grid, const std::array<cl_float, 2> &range, const std::array<cl_float, 2> &lines);
+    void scanConvert(Shape in, const frame_t &input, Shape out, frame_t &output, const Table &table);
+
+    // Host ports of raytracing.cl, output pixels packed like the kernels'.
+    void render(cl_uint wOut, cl_uint lOut, std::vector<cl_uint> &output, Shape s, const frame_t &data, const std::array<float, 12> &invMVTransposed);
+    void renderPolar(cl_uint wOut, cl_uint lOut, std::vector<cl_uint> &output, Shape s, const frame_t &data, const std::array<float, 12> &invMVTransposed, cl_float ratio, cl_float angleDelta);
+
+} // namespace native
+
+#endif
\ No newline at end of file
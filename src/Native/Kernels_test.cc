@@ -0,0 +1,604 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <CL/cl2.hpp>
+
+#include "Kernels.hh"
+
+#include "../Data/Volume.hh"
+#include "../OpenCL/Device.hh"
+#include "../OpenCL/ScanTable.hh"
+#include "../OpenCL/Kernels/Gaussian.hh"
+#include "../OpenCL/Kernels/ToCartesian.hh"
+#include "../OpenCL/Kernels/ToPolar.hh"
+#include "../Ultrasound/Mindray.hh"
+
+// Runs every host port of src/Native next to the OpenCL kernel it mirrors, with the arguments the opencl::
+// filters give them, on the first frame of each exam in tests/data and compares the outputs byte for byte.
+// Built and run by `make check` from the repository root, exits non-zero on any difference.
+
+namespace
+{
+    using native::frame_t;
+    using native::Shape;
+
+    int failures = 0;
+
+    struct Exam
+    {
+        std::string name;
+        std::shared_ptr<data::Volume> volume; // buffer holds frame 0
+        Shape shape;
+
+        const frame_t &frame() const { return volume->raw[0]; }
+        std::size_t voxels() const { return shape.voxels(); }
+    };
+
+    template <typename T>
+    cl::Buffer upload(const cl::Context &context, const std::vector<T> &v)
+    {
+        return cl::Buffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, v.size() * sizeof(T), const_cast<T *>(v.data()));
+    }
+
+    template <typename T>
+    std::vector<T> download(cl::CommandQueue &queue, const cl::Buffer &b, std::size_t n)
+    {
+        std::vector<T> v(n);
+        queue.enqueueReadBuffer(b, CL_TRUE, 0, n * sizeof(T), v.data());
+        return v;
+    }
+
+    // tolerance is the largest byte difference let through, 0 unless the device build uses native_ maths.
+    template <typename T>
+    void compare(const std::string &name, const std::vector<T> &device, const std::vector<T> &host, int tolerance = 0)
+    {
+        const cl_uchar *a = reinterpret_cast<const cl_uchar *>(device.data());
+        const cl_uchar *b = reinterpret_cast<const cl_uchar *>(host.data());
+        std::size_t bytes = std::min(device.size(), host.size()) * sizeof(T);
+        std::size_t differ = device.size() == host.size() ? 0 : 1;
+        int worst = 0;
+        for (std::size_t i = 0; i < bytes; ++i)
+        {
+            int d = std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i]));
+            worst = std::max(worst, d);
+            differ += d > tolerance;
+        }
+
+        std::cout << (differ ? "FAIL " : "ok   ") << name << ", " << differ << " of " << bytes << " bytes differ, largest by " << worst << '\n';
+        failures += differ != 0;
+    }
+
+    // The plain kernel, then its Wide variant at 16 and 64 voxels a work-item when the program has one.
+    void pointwise(opencl::Device &d, const Exam &e, const std::string &name, const std::function<void(opencl::Kernel &)> &args, const std::function<void(const frame_t &, frame_t &)> &host, int tolerance = 0)
+    {
+        frame_t expected(e.voxels());
+        host(e.frame(), expected);
+
+        auto &kernels = d.programs.at("utility")->kernels;
+        opencl::Kernel &kernel = *kernels.at(name);
+        std::shared_ptr<opencl::Kernel> wide = kernels.contains(name + "Wide") ? kernels.at(name + "Wide") : nullptr;
+        std::shared_ptr<opencl::Kernel> kept = kernel.wide;
+        cl_uint keptVoxels = wide ? wide->voxels : 0;
+
+        for (cl_uint voxels : {0u, 16u, 64u})
+        {
+            if (voxels != 0 && !wide)
+                break;
+
+            kernel.wide = voxels == 0 ? nullptr : wide;
+            if (wide)
+                wide->voxels = voxels;
+
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+            opencl::Kernel &k = kernel.pointwise(e.shape.depth, e.shape.length, e.shape.width, 1);
+            k.setArg(3, e.volume->buffer);
+            k.setArg(4, out);
+            args(k);
+            k.execute(d.cQueue);
+
+            std::string label = voxels == 0 ? name : name + "Wide/" + std::to_string(voxels);
+            compare(e.name + ' ' + label, download<cl_uchar4>(d.cQueue, out, e.voxels()), expected, tolerance);
+        }
+
+        kernel.wide = kept;
+        if (wide)
+            wide->voxels = keptVoxels;
+    }
+
+    void pointwise(opencl::Device &d, const Exam &e)
+    {
+        pointwise(
+            d, e, "threshold", [](opencl::Kernel &k)
+            { k.setArg(5, static_cast<cl_uchar>(0x80)); },
+            [](const frame_t &i, frame_t &o)
+            { native::threshold(i, o, 0x80); });
+        pointwise(
+            d, e, "invert", [](opencl::Kernel &) {}, [](const frame_t &i, frame_t &o)
+            { native::invert(i, o); });
+        pointwise(
+            d, e, "contrast", [](opencl::Kernel &k)
+            {
+                k.setArg(5, static_cast<cl_uchar>(0x10));
+                k.setArg(6, static_cast<cl_uchar>(0xF0)); },
+            [](const frame_t &i, frame_t &o)
+            { native::contrast(i, o, 0x10, 0xF0); });
+        pointwise(
+            d, e, "fade", [](opencl::Kernel &) {}, [](const frame_t &i, frame_t &o)
+            { native::fade(i, o); });
+        pointwise(
+            d, e, "colourise", [](opencl::Kernel &k)
+            {
+                k.setArg(5, 0.25f);
+                k.setArg(6, 0.5f);
+                k.setArg(7, 0.75f); },
+            [](const frame_t &i, frame_t &o)
+            { native::colourise(i, o, 0.25f, 0.5f, 0.75f); });
+
+        // native_log2 and native_sqrt, the host has only the exact functions.
+        pointwise(
+            d, e, "logTwo", [](opencl::Kernel &) {}, [](const frame_t &i, frame_t &o)
+            { native::logTwo(i, o); },
+            1);
+        pointwise(
+            d, e, "square", [](opencl::Kernel &) {}, [](const frame_t &i, frame_t &o)
+            { native::square(i, o); },
+            1);
+    }
+
+    void stencils(opencl::Device &d, const Exam &e)
+    {
+        opencl::Program &utility = *d.programs.at("utility");
+        const Shape s = e.shape;
+        const cl::NDRange volume(s.depth, s.length, s.width);
+
+        // Dimensions, input and output, as every wrapper sets them.
+        auto bind = [&](opencl::Kernel &k, const cl::Buffer &out)
+        {
+            k.specialise(s.depth, s.length, s.width);
+            k.setArg(0, s.depth);
+            k.setArg(1, s.length);
+            k.setArg(2, s.width);
+            k.setArg(3, e.volume->buffer);
+            k.setArg(4, out);
+        };
+        auto check = [&](opencl::Kernel &k, const cl::Buffer &out, const std::string &name, const frame_t &expected)
+        {
+            k.execute(d.cQueue);
+            compare(e.name + ' ' + name, download<cl_uchar4>(d.cQueue, out, e.voxels()), expected);
+        };
+
+        {
+            const std::vector<cl_float> slices = {0.25f, 0.5f, 0.75f};
+            frame_t expected(e.voxels());
+            native::slice(s, e.frame(), expected, {slices[0], slices[1], slices[2]});
+
+            opencl::Kernel &k = *utility.at("slice");
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+            bind(k, out);
+            k.setArg(5, 1u);
+            k.setArg(6, 1u);
+            k.setArg(7, 1u);
+            k.setArg(8, upload(d.context, slices));
+            k.global = volume;
+            check(k, out, "slice", expected);
+        }
+
+        {
+            const std::array<cl_float, 6> bounds = {0.1f, 0.9f, 0.2f, 0.8f, 0.0f, 0.6f};
+            frame_t expected(e.voxels());
+            native::clamping(s, e.frame(), expected, bounds);
+
+            opencl::Kernel &k = *utility.at("clamping");
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+            bind(k, out);
+            for (unsigned int i = 0; i < bounds.size(); ++i)
+                k.setArg(i + 5, bounds[i]);
+            k.global = volume;
+            check(k, out, "clamping", expected);
+        }
+
+        {
+            frame_t expected(e.voxels());
+            native::shrink(s, e.frame(), expected);
+
+            opencl::Kernel &k = *utility.at("shrink");
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+            bind(k, out);
+            k.setArg(5, static_cast<cl_uchar *>(nullptr), k.tile(d.cQueue, s.depth, s.length, s.width, 1, 3));
+            check(k, out, "shrink", expected);
+        }
+
+        // opencl::Median takes the selection network up to 125 taps and the histogram past it.
+        {
+            const cl_uint r = 1;
+            frame_t expected(e.voxels());
+            native::median(s, e.frame(), expected, r);
+
+            opencl::Kernel &k = *utility.at("medianNetwork");
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+            bind(k, out);
+            k.setArg(5, static_cast<cl_uchar *>(nullptr), k.tile(d.cQueue, s.depth, s.length, s.width, 1, r));
+            k.setArg(6, r);
+            check(k, out, "medianNetwork", expected);
+        }
+
+        {
+            const cl_uint r = 3;
+            frame_t expected(e.voxels());
+            native::median(s, e.frame(), expected, r);
+
+            opencl::Kernel &k = *utility.at("medianHistogram");
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+            bind(k, out);
+            k.setArg(5, r);
+            k.global = cl::NDRange(s.length, s.width);
+            check(k, out, "medianHistogram", expected);
+        }
+    }
+
+    // One work-item per line along each axis, a 2D volume skips the width pass.
+    cl::NDRange lines(Shape s, cl_uint axis)
+    {
+        return axis == 0 ? cl::NDRange(s.length, s.width) : axis == 1 ? cl::NDRange(s.depth, s.width) : cl::NDRange(s.depth, s.length);
+    }
+
+    void separable(opencl::Device &d, const Exam &e)
+    {
+        opencl::Program &utility = *d.programs.at("utility");
+        const Shape s = e.shape;
+        const cl_uint axes = s.width == 1 ? 2u : 3u;
+
+        auto dimensions = [&](opencl::Kernel &k)
+        {
+            k.setArg(0, s.depth);
+            k.setArg(1, s.length);
+            k.setArg(2, s.width);
+        };
+
+        {
+            cl_float4 c = opencl::Gaussian::coefficients(opencl::Gaussian::sigma(0.15f));
+            frame_t expected(e.voxels());
+            native::gaussian(s, e.frame(), expected, {c.s[0], c.s[1], c.s[2], c.s[3]});
+
+            std::array<cl::Buffer, 2> alpha;
+            for (auto &a : alpha)
+                a = cl::Buffer(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_float));
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+
+            opencl::Kernel &toFloat = *utility.at("alphaToFloat");
+            dimensions(toFloat);
+            toFloat.setArg(3, e.volume->buffer);
+            toFloat.setArg(4, alpha[0]);
+            toFloat.global = cl::NDRange(e.voxels());
+            toFloat.execute(d.cQueue);
+
+            opencl::Kernel &iir = *utility.at("gaussianIIR");
+            iir.specialise(s.depth, s.length, s.width);
+            dimensions(iir);
+            iir.setArg(6, c);
+            std::size_t src = 0;
+            for (cl_uint axis = 0; axis < axes; ++axis)
+            {
+                iir.setArg(3, alpha[src]);
+                iir.setArg(4, alpha[1 - src]);
+                iir.setArg(5, axis);
+                iir.global = lines(s, axis);
+                iir.execute(d.cQueue);
+                src = 1 - src;
+            }
+
+            opencl::Kernel &fromFloat = *utility.at("floatToAlpha");
+            dimensions(fromFloat);
+            fromFloat.setArg(3, e.volume->buffer);
+            fromFloat.setArg(4, alpha[src]);
+            fromFloat.setArg(5, out);
+            fromFloat.global = cl::NDRange(e.voxels());
+            fromFloat.execute(d.cQueue);
+
+            compare(e.name + " gaussian", download<cl_uchar4>(d.cQueue, out, e.voxels()), expected);
+        }
+
+        // An opening, erosion then dilation, radius 2 along every axis.
+        {
+            const cl_uint r = 2;
+            const std::array<cl_uint, 3> dims = {s.depth, s.length, s.width};
+
+            std::vector<cl_uchar> hostAlpha(e.voxels());
+            std::transform(e.frame().begin(), e.frame().end(), hostAlpha.begin(), [](const cl_uchar4 &v)
+                           { return v.s[3]; });
+            for (cl_uint dilate = 0; dilate < 2; ++dilate)
+                for (cl_uint axis = 0; axis < axes; ++axis)
+                    native::morphologyLine(s, hostAlpha, axis, r, dilate != 0);
+            frame_t expected = e.frame();
+            for (std::size_t i = 0; i < expected.size(); ++i)
+                expected[i].s[3] = hostAlpha[i];
+
+            std::size_t need = 0;
+            for (std::size_t i = 0; i < dims.size(); ++i)
+                need = std::max(need, e.voxels() + e.voxels() / dims[i] * 2 * r);
+
+            std::array<cl::Buffer, 2> alpha;
+            for (auto &a : alpha)
+                a = cl::Buffer(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar));
+            cl::Buffer scratch(d.context, CL_MEM_READ_WRITE, need);
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+
+            opencl::Kernel &extract = *utility.at("extractAlpha");
+            dimensions(extract);
+            extract.setArg(3, e.volume->buffer);
+            extract.setArg(4, alpha[0]);
+            extract.global = cl::NDRange(e.voxels());
+            extract.execute(d.cQueue);
+
+            opencl::Kernel &line = *utility.at("morphologyLine");
+            line.specialise(s.depth, s.length, s.width);
+            dimensions(line);
+            line.setArg(5, scratch);
+            std::size_t src = 0;
+            for (cl_uint dilate = 0; dilate < 2; ++dilate)
+            {
+                for (cl_uint axis = 0; axis < axes; ++axis)
+                {
+                    line.setArg(3, alpha[src]);
+                    line.setArg(4, alpha[1 - src]);
+                    line.setArg(6, axis);
+                    line.setArg(7, r);
+                    line.setArg(8, dilate);
+                    line.global = lines(s, axis);
+                    line.execute(d.cQueue);
+                    src = 1 - src;
+                }
+            }
+
+            opencl::Kernel &insert = *utility.at("insertAlpha");
+            dimensions(insert);
+            insert.setArg(3, e.volume->buffer);
+            insert.setArg(4, alpha[src]);
+            insert.setArg(5, out);
+            insert.global = cl::NDRange(e.voxels());
+            insert.execute(d.cQueue);
+
+            compare(e.name + " morphology", download<cl_uchar4>(d.cQueue, out, e.voxels()), expected);
+        }
+
+        // Mean, variance and the adaptive threshold over one set of integral tables.
+        {
+            const std::array<cl_uint, 3> r = {2, 3, s.width == 1 ? 0u : 2u};
+            const cl_float bias = 8.0f;
+
+            std::array<cl::Buffer, 2> sum, squares;
+            for (std::size_t i = 0; i < 2; ++i)
+            {
+                sum[i] = cl::Buffer(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uint));
+                squares[i] = cl::Buffer(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_ulong));
+            }
+
+            opencl::Kernel &integral = *utility.at("integralLine");
+            integral.specialise(s.depth, s.length, s.width);
+            dimensions(integral);
+            integral.setArg(3, e.volume->buffer);
+            for (cl_uint axis = 0; axis < axes; ++axis)
+            {
+                cl_uint dst = axis % 2;
+                integral.setArg(4, sum[1 - dst]);
+                integral.setArg(5, squares[1 - dst]);
+                integral.setArg(6, sum[dst]);
+                integral.setArg(7, squares[dst]);
+                integral.setArg(8, axis);
+                integral.global = lines(s, axis);
+                integral.execute(d.cQueue);
+            }
+            cl_uint last = (axes - 1) % 2;
+
+            for (cl_uint statistic = 0; statistic < 3; ++statistic)
+            {
+                frame_t expected(e.voxels());
+                native::boxStatistics(s, e.frame(), expected, r, statistic, statistic == 2 ? bias : 0.0f);
+
+                cl::Buffer out(d.context, CL_MEM_READ_WRITE, e.voxels() * sizeof(cl_uchar4));
+                opencl::Kernel &k = utility.at("boxStatistics")->pointwise(s.depth, s.length, s.width, 1);
+                k.setArg(3, e.volume->buffer);
+                k.setArg(4, sum[last]);
+                k.setArg(5, squares[last]);
+                k.setArg(6, out);
+                k.setArg(7, cl_uint4{{r[0], r[1], r[2], 0}});
+                k.setArg(8, statistic);
+                k.setArg(9, statistic == 2 ? bias : 0.0f);
+                k.execute(d.cQueue);
+
+                compare(e.name + " boxStatistics/" + std::to_string(statistic), download<cl_uchar4>(d.cQueue, out, e.voxels()), expected);
+            }
+        }
+    }
+
+    // The tables both backends build for a geometry, then the gather through them.
+    void scanConversion(opencl::Device &d, const Exam &e)
+    {
+        opencl::Program &cartesian = *d.programs.at("cartesian");
+        const data::Volume &v = *e.volume;
+        const Shape in = e.shape;
+
+        auto gather = [&](const std::string &name, std::array<cl_uint, 3> dims, opencl::Kernel &build, const opencl::ScanTable::Geometry &g, const native::Table &table)
+        {
+            const Shape out = {dims[0], dims[1], dims[2]};
+            frame_t expected(out.voxels());
+            native::scanConvert(in, e.frame(), out, expected, table);
+
+            auto t = opencl::ScanTable::get(d.context, d.cQueue, build, g);
+            cl::Buffer output(d.context, CL_MEM_READ_WRITE, out.voxels() * sizeof(cl_uchar4));
+            opencl::Kernel &k = *cartesian.at("scanConvert");
+            k.setArg(0, in.depth);
+            k.setArg(1, in.length);
+            k.setArg(2, in.width);
+            k.setArg(3, e.volume->buffer);
+            k.setArg(4, out.depth);
+            k.setArg(5, out.length);
+            k.setArg(6, out.width);
+            k.setArg(7, output);
+            k.setArg(8, t->index);
+            k.setArg(9, t->weight);
+            k.global = cl::NDRange(out.depth, out.length, out.width);
+            k.execute(d.cQueue);
+
+            compare(e.name + ' ' + name, download<cl_uchar4>(d.cQueue, output, out.voxels()), expected);
+        };
+
+        {
+            auto dims = opencl::ToPolar::outputShape(v);
+            const Shape out = {dims[0], dims[1], dims[2]};
+            gather("sphericalTable", dims, *cartesian.at("sphericalTable"), {{in.depth, in.length, in.width}, dims, v.ratio, v.delta}, native::sphericalTable(in, out, v.ratio, v.delta));
+        }
+
+        {
+            std::array<cl_uint, 3> dims = {in.depth, in.length, in.width};
+            std::array<cl_float, 4> grid = {0.0f, 0.0f, 0.0f, 0.0f};
+            bool physical = opencl::ToCartesian::fanGrid(v, 1.0f / 3.0f, dims, grid);
+            const Shape out = {dims[0], dims[1], dims[2]};
+
+            opencl::ScanTable::Geometry g = {{in.depth, in.length, in.width}, dims, v.ratio, v.delta};
+            if (physical)
+            {
+                g.grid = grid;
+                g.range = v.pointRange;
+                g.lines = v.lineRange;
+                gather("fanTable", dims, *cartesian.at("fanTable"), g, native::fanTable(in, out, v.delta, grid, v.pointRange, v.lineRange));
+            }
+            else
+            {
+                gather("cartesianTable", dims, *cartesian.at("cartesianTable"), g, native::cartesianTable(in, out, v.ratio, v.delta));
+            }
+        }
+    }
+
+    void rendering(opencl::Device &d, const Exam &e)
+    {
+        const cl_uint w = 256, h = 256;
+        const Shape s = e.shape;
+
+        // Looking down -z at the unit cube from 4 away.
+        const std::array<float, 12> inv = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 4.0f};
+        cl::Buffer invMV = upload(d.context, std::vector<float>(inv.begin(), inv.end()));
+
+        for (bool polar : {false, true})
+        {
+            std::vector<cl_uint> expected(static_cast<std::size_t>(w) * h);
+            if (polar)
+                native::renderPolar(w, h, expected, s, e.frame(), inv, e.volume->ratio, e.volume->delta);
+            else
+                native::render(w, h, expected, s, e.frame(), inv);
+
+            cl::Buffer out(d.context, CL_MEM_READ_WRITE, expected.size() * sizeof(cl_uint));
+            opencl::Kernel &k = *d.programs.at("raytracing")->at(polar ? "renderPolar" : "render");
+            k.setArg(0, w);
+            k.setArg(1, h);
+            k.setArg(2, out);
+            k.setArg(3, s.depth);
+            k.setArg(4, s.length);
+            k.setArg(5, s.width);
+            k.setArg(6, e.volume->buffer);
+            k.setArg(7, invMV);
+            if (polar)
+            {
+                k.setArg(8, e.volume->ratio);
+                k.setArg(9, e.volume->delta);
+            }
+            k.global = cl::NDRange(w, h);
+            k.execute(d.cQueue);
+
+            // native_divide, native_sqrt and fast_length along the ray.
+            compare(e.name + (polar ? " renderPolar" : " render"), download<cl_uint>(d.cQueue, out, expected.size()), expected, 2);
+        }
+    }
+
+} // namespace
+
+int main(int, char *[])
+{
+    try
+    {
+        // A CPU device where there is one, it is the one with the wide kernels.
+        std::vector<cl::Platform> platforms;
+        cl::Platform::get(&platforms);
+        cl::Platform platform;
+        cl::Device device;
+        for (auto &p : platforms)
+        {
+            std::vector<cl::Device> devices;
+            p.getDevices(CL_DEVICE_TYPE_ALL, &devices);
+            for (auto &dev : devices)
+            {
+                if (device() == nullptr || (dev.getInfo<CL_DEVICE_TYPE>() == CL_DEVICE_TYPE_CPU && device.getInfo<CL_DEVICE_TYPE>() != CL_DEVICE_TYPE_CPU))
+                {
+                    platform = p;
+                    device = dev;
+                }
+            }
+        }
+        if (device() == nullptr)
+        {
+            std::cerr << "No OpenCL device." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        opencl::Device d(platform, device);
+        d.initialise(false);
+        std::cout << "Device: " << device.getInfo<CL_DEVICE_NAME>() << '\n';
+
+        std::vector<std::filesystem::path> dirs;
+        for (const auto &entry : std::filesystem::directory_iterator("./tests/data"))
+            if (entry.is_directory())
+                dirs.push_back(entry.path());
+        std::sort(dirs.begin(), dirs.end());
+
+        std::size_t exams = 0;
+        for (const auto &dir : dirs)
+        {
+            // Mindray::load reports missing files in a message box, check first.
+            if (!std::filesystem::exists(dir / "BC_CinePartition0.bin"))
+            {
+                std::cout << "skip " << dir.filename().string() << ", no cine partition\n";
+                continue;
+            }
+
+            ultrasound::Mindray reader(d.context);
+            reader.volume = std::make_shared<data::Volume>();
+            if (!reader.load(dir.string().c_str()))
+            {
+                std::cout << "FAIL " << dir.filename().string() << ", does not load\n";
+                ++failures;
+                continue;
+            }
+
+            Exam e = {dir.filename().string(), reader.volume, {reader.volume->depth, reader.volume->length, reader.volume->width}};
+            std::cout << e.name << ": " << e.shape.depth << 'x' << e.shape.length << 'x' << e.shape.width << '\n';
+
+            pointwise(d, e);
+            stencils(d, e);
+            separable(d, e);
+            scanConversion(d, e);
+            rendering(d, e);
+            ++exams;
+        }
+
+        if (exams == 0)
+        {
+            std::cerr << "No exams in ./tests/data, run from the repository root." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const cl::Error &e)
+    {
+        std::cerr << "Parity, " << e.what() << " : " << e.err() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << (failures ? std::to_string(failures) + " failed" : std::string("all passed")) << std::endl;
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
\ No newline at end of file
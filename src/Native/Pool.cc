@@ -0,0 +1,110 @@
+#include "Pool.hh"
+
+#include <algorithm>
+
+namespace native
+{
+
+    Pool::Pool(unsigned int threads)
+    {
+        // The caller works too, so one thread fewer than the cores.
+        for (unsigned int i = 1; i < std::max(threads, 1u); ++i)
+        {
+            workers.emplace_back([this]()
+                                 { run(); });
+        }
+    }
+
+    Pool::~Pool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stop = true;
+        }
+        wake.notify_all();
+
+        for (auto &w : workers)
+        {
+            w.join();
+        }
+    }
+
+    Pool &Pool::shared()
+    {
+        static Pool pool;
+        return pool;
+    }
+
+    void Pool::run()
+    {
+        std::size_t seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&]()
+                          { return stop || generation != seen; });
+                if (stop)
+                    return;
+                seen = generation;
+                ++active;
+            }
+
+            work();
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                --active;
+            }
+            finished.notify_all();
+        }
+    }
+
+    void Pool::work()
+    {
+        for (std::size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1))
+        {
+            (*body)(c * grain, std::min(count, (c + 1) * grain));
+            done.fetch_add(1);
+        }
+    }
+
+    void Pool::parallelFor(std::size_t n, const body_t &f, std::size_t g)
+    {
+        if (n == 0)
+            return;
+
+        // Small loops aren't worth waking anyone for.
+        if (workers.empty() || n <= g)
+        {
+            f(0, n);
+            return;
+        }
+
+        std::lock_guard<std::mutex> one(serial);
+
+        {
+            // A worker late from the last loop may still be on its way out of work().
+            std::unique_lock<std::mutex> guard(lock);
+            finished.wait(guard, [&]()
+                          { return active == 0; });
+            body = &f;
+            count = n;
+            grain = g;
+            chunks = (n + g - 1) / g;
+            next = 0;
+            done = 0;
+            ++generation;
+        }
+        wake.notify_all();
+
+        work();
+
+        // Every chunk finished and no worker still reading this loop's state.
+        std::unique_lock<std::mutex> guard(lock);
+        finished.wait(guard, [&]()
+                      { return done == chunks && active == 0; });
+        body = nullptr;
+    }
+
+} // namespace native
\ No newline at end of file
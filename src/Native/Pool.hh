@@ -0,0 +1,54 @@
+#ifndef NATIVE_POOL_HH
+#define NATIVE_POOL_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace native
+{
+
+    // Persistent worker threads for the host backend. parallelFor splits [0, n) into chunks of grain that the
+    // workers (and the caller) take in turn, one loop runs at a time and loops must not nest.
+    class Pool
+    {
+    public:
+        using body_t = std::function<void(std::size_t, std::size_t)>;
+
+    private:
+        std::vector<std::thread> workers;
+        std::mutex lock;
+        std::mutex serial;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        std::size_t generation = 0;
+        std::size_t active = 0;
+        bool stop = false;
+
+        // Current loop, only written while no worker is inside work()
+        const body_t *body = nullptr;
+        std::size_t count = 0;
+        std::size_t grain = 1;
+        std::size_t chunks = 0;
+        std::atomic<std::size_t> next = 0;
+        std::atomic<std::size_t> done = 0;
+
+        void run();
+        void work();
+
+    public:
+        Pool(unsigned int threads = std::thread::hardware_concurrency());
+        ~Pool();
+
+        static Pool &shared();
+
+        void parallelFor(std::size_t n, const body_t &f, std::size_t g = 4096);
+    };
+
+} // namespace native
+
+#endif
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "Arena.hh"
+
+#include <algorithm>
+#include <iostream>
+
+namespace opencl
+{
+
+    std::size_t Arena::budget = std::size_t(1024) << 20;
+    std::size_t Arena::block = std::size_t(64) << 20;
+    std::function<bool(void)> Arena::reclaim;
+
+    Arena::State &Arena::state()
+    {
+        static State *s = new State;
+        return *s;
+    }
+
+    cl::Buffer Arena::allocate(const cl::Context &context, std::size_t bytes)
+    {
+        State &s = state();
+        bytes = std::max<std::size_t>(bytes, 1);
+        for (;;)
+        {
+            {
+                std::lock_guard<std::mutex> guard(s.lock);
+                Pool &p = pool(context);
+                std::size_t size = std::max((bytes + p.align - 1) / p.align * p.align, p.align);
+
+                for (auto &b : p.blocks)
+                {
+                    cl::Buffer sub = carve(b, size, bytes);
+                    if (sub() != nullptr)
+                        return sub;
+                }
+
+                std::size_t want = std::max(size, std::min(block, p.maxAlloc));
+                if (s.total + want <= budget)
+                {
+                    try
+                    {
+                        p.blocks.push_back({cl::Buffer(context, CL_MEM_READ_WRITE, want), want, 0, {}});
+                        p.blocks.back().free.emplace(0, want);
+                        s.total += want;
+                        return carve(p.blocks.back(), size, bytes);
+                    }
+                    catch (const cl::Error &e)
+                    {
+                        if (e.err() != CL_MEM_OBJECT_ALLOCATION_FAILURE && e.err() != CL_OUT_OF_RESOURCES)
+                            throw;
+                    }
+                }
+
+                if (trim())
+                    continue;
+            }
+
+            // Outside the lock, whatever reclaim releases comes back through release().
+            std::lock_guard<std::mutex> shedding(s.reclaimer);
+            if (!reclaim || !reclaim())
+            {
+                std::cerr << "Arena, " << bytes << " bytes do not fit in " << s.total << " reserved of " << budget << '\n';
+                throw cl::Error(CL_MEM_OBJECT_ALLOCATION_FAILURE, "Arena::allocate");
+            }
+        }
+    }
+
+    std::size_t Arena::reserved()
+    {
+        State &s = state();
+        std::lock_guard<std::mutex> guard(s.lock);
+        return s.total;
+    }
+
+    Arena::Pool &Arena::pool(const cl::Context &context)
+    {
+        auto &pools = state().pools;
+        auto itr = pools.find(context());
+        if (itr != pools.end())
+            return itr->second;
+
+        // Sub-buffer origins have to suit every device of the context, the alignment is given in bits.
+        Pool p{1, ~std::size_t(0), {}};
+        for (const auto &d : context.getInfo<CL_CONTEXT_DEVICES>())
+        {
+            p.align = std::max<std::size_t>(p.align, d.getInfo<CL_DEVICE_MEM_BASE_ADDR_ALIGN>() / 8);
+            p.maxAlloc = std::min<std::size_t>(p.maxAlloc, d.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>());
+        }
+        return pools.emplace(context(), std::move(p)).first->second;
+    }
+
+    // First fit of the aligned size, a null buffer when no free region of the block is large enough. The
+    // sub-buffer itself is exactly bytes long, callers check CL_MEM_SIZE against the volume.
+    cl::Buffer Arena::carve(Block &b, std::size_t size, std::size_t bytes)
+    {
+        auto itr = std::find_if(b.free.begin(), b.free.end(), [size](const auto &f)
+                                { return f.second >= size; });
+        if (itr == b.free.end())
+            return cl::Buffer();
+
+        cl_buffer_region region = {itr->first, bytes};
+        cl::Buffer sub = b.buffer.createSubBuffer(CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &region);
+        sub.setDestructorCallback(release, new Region{&b, itr->first, size});
+
+        if (itr->second > size)
+            b.free.emplace(itr->first + size, itr->second - size);
+        b.free.erase(itr);
+        b.used += size;
+        return sub;
+    }
+
+    bool Arena::trim()
+    {
+        State &s = state();
+        bool freed = false;
+        for (auto &entry : s.pools)
+        {
+            entry.second.blocks.remove_if([&s, &freed](const Block &b)
+                               {
+                                   if (b.used != 0)
+                                       return false;
+                                   s.total -= b.size;
+                                   freed = true;
+                                   return true; });
+        }
+        return freed;
+    }
+
+    void CL_CALLBACK Arena::release(cl_mem, void *user)
+    {
+        Region *r = static_cast<Region *>(user);
+        std::lock_guard<std::mutex> guard(state().lock);
+
+        Block &b = *r->block;
+        b.used -= r->size;
+
+        auto itr = b.free.emplace(r->offset, r->size).first;
+        if (auto next = std::next(itr); next != b.free.end() && itr->first + itr->second == next->first)
+        {
+            itr->second += next->second;
+            b.free.erase(next);
+        }
+        if (itr != b.free.begin())
+        {
+            auto prev = std::prev(itr);
+            if (prev->first + prev->second == itr->first)
+            {
+                prev->second += itr->second;
+                b.free.erase(itr);
+            }
+        }
+
+        delete r;
+    }
+
+} // namespace opencl
\ No newline at end of file
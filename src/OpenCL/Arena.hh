@@ -0,0 +1,72 @@
+#ifndef OPENCL_ARENA_HH
+#define OPENCL_ARENA_HH
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+
+#include <CL/cl2.hpp>
+
+namespace opencl
+{
+
+    // Device memory for filter outputs and scratch. Each context reserves blocks and hands out sub-buffers
+    // aligned to its devices' CL_DEVICE_MEM_BASE_ADDR_ALIGN, a region is free again once its last cl::Buffer is
+    // released. Blocks count against one budget across contexts, past it (or when the driver refuses a block)
+    // empty blocks are returned and reclaim is asked to release memory before the allocation gives up.
+    class Arena
+    {
+    public:
+        static std::size_t budget;
+        static std::size_t block;                  // Reservation size, larger allocations get a block of their own
+        static std::function<bool(void)> reclaim; // Frees some device memory, false once there is nothing left to free
+
+        // Throws cl::Error (CL_MEM_OBJECT_ALLOCATION_FAILURE) once nothing more can be freed.
+        static cl::Buffer allocate(const cl::Context &context, std::size_t bytes);
+        static std::size_t reserved();
+
+    private:
+        struct Block
+        {
+            cl::Buffer buffer;
+            std::size_t size;
+            std::size_t used = 0;
+            std::map<std::size_t, std::size_t> free; // Offset to size, neighbours are merged
+        };
+
+        struct Pool
+        {
+            std::size_t align;
+            std::size_t maxAlloc;
+            std::list<Block> blocks; // Addresses stay put, regions point at their block
+        };
+
+        struct Region
+        {
+            Block *block;
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        // Leaked on purpose, static caches (FrameCache, ScanTable) release their sub-buffers during static
+        // destruction and the callbacks still need the blocks.
+        struct State
+        {
+            std::mutex lock;      // Regions are released from the driver's callback thread
+            std::mutex reclaimer; // Export stages allocate from their own threads, reclaim runs one at a time
+            std::map<cl_context, Pool> pools;
+            std::size_t total = 0;
+        };
+
+        static State &state();
+        static Pool &pool(const cl::Context &context);
+        static cl::Buffer carve(Block &b, std::size_t size, std::size_t bytes);
+        static bool trim();
+        static void CL_CALLBACK release(cl_mem memobj, void *user);
+    };
+
+} // namespace opencl
+
+#endif
\ No newline at end of file
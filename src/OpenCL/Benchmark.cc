@@ -0,0 +1,208 @@
+#include "Benchmark.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using opencl::Device;
+    using opencl::Kernel;
+    using opencl::Program;
+    using opencl::Source;
+
+    std::vector<cl_uchar4> noise(std::size_t voxels)
+    {
+        std::vector<cl_uchar4> host(voxels);
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<int> dist(0, 255);
+        for (auto &v : host)
+        {
+            v.s[0] = v.s[1] = v.s[2] = v.s[3] = static_cast<cl_uchar>(dist(gen));
+        }
+        return host;
+    }
+
+    // Best of five runs, in ms.
+    float measure(Device &device, Kernel &k)
+    {
+        float best = std::numeric_limits<float>::max();
+        for (int r = 0; r < 5; ++r)
+        {
+            device.cQueue.finish();
+            auto start = std::chrono::steady_clock::now();
+            k.execute(device.cQueue);
+            device.cQueue.finish();
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(stop - start).count());
+        }
+        return best;
+    }
+
+    // Platform, device and driver, so results from different machines and drivers can be told apart.
+    void describe(Device &device)
+    {
+        cl::Device d = device.cQueue.getInfo<CL_QUEUE_DEVICE>();
+        cl::Platform p(d.getInfo<CL_DEVICE_PLATFORM>());
+        std::cout << "  " << p.getInfo<CL_PLATFORM_NAME>() << ", " << d.getInfo<CL_DEVICE_NAME>()
+                  << ", driver " << d.getInfo<CL_DRIVER_VERSION>() << ", " << d.getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>()
+                  << " compute units, preferred char vector " << d.getInfo<CL_DEVICE_PREFERRED_VECTOR_WIDTH_CHAR>() << '\n';
+    }
+}
+
+namespace opencl
+{
+
+    void Benchmark::stencils(Device &device, cl_uint depth, cl_uint length, cl_uint width)
+    {
+        struct Case
+        {
+            std::string name;  // In reference.cl
+            std::string tiled; // In utility.cl
+            cl_uint radius;
+            cl_uint taps; // Global reads per voxel in the untiled kernel
+        };
+        const std::vector<Case> cases = {{"medianNoise3D", "medianNetwork", 1, 27}, {"shrink", "shrink", 3, 19}};
+
+        std::size_t voxels = std::size_t(depth) * length * width;
+
+        std::vector<cl_uchar4> host = noise(voxels);
+
+        try
+        {
+            cl::Buffer in(device.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, voxels * sizeof(cl_uchar4), host.data());
+            cl::Buffer out(device.context, CL_MEM_WRITE_ONLY, voxels * sizeof(cl_uchar4));
+
+            // The untiled kernels are only built for the benchmark, they are kept out of ./filters.
+            if (!device.programs.contains("reference"))
+                device.programs.emplace("reference", std::make_shared<Program>(device.context, Source("./bench/reference.cl")));
+
+            std::cout << "Stencil benchmark, " << depth << 'x' << length << 'x' << width << ":\n";
+            describe(device);
+            for (const Case &c : cases)
+            {
+                auto &ref = device.programs.at("reference")->at(c.name);
+                ref->setArg(0, depth);
+                ref->setArg(1, length);
+                ref->setArg(2, width);
+                ref->setArg(3, in);
+                ref->setArg(4, out);
+                ref->global = cl::NDRange(depth, length, width);
+                float refTime = measure(device, *ref);
+
+                auto &tiled = device.programs.at("utility")->at(c.tiled);
+                tiled->specialise(depth, length, width);
+                tiled->setArg(0, depth);
+                tiled->setArg(1, length);
+                tiled->setArg(2, width);
+                tiled->setArg(3, in);
+                tiled->setArg(4, out);
+                std::size_t tileBytes = tiled->tile(device.cQueue, depth, length, width, 1, c.radius);
+                tiled->setArg(5, static_cast<cl_uchar *>(nullptr), tileBytes);
+                if (tiled->numArgs() > 6)
+                    tiled->setArg(6, c.radius);
+                float tiledTime = measure(device, *tiled);
+
+                // Tiles load the .w channel of every voxel they cover (halo included) plus the centre voxel.
+                std::size_t groups = 1;
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    groups *= tiled->global[i] / tiled->local[i];
+                }
+                double refMB = double(voxels) * c.taps * sizeof(cl_uchar4) / 1e6;
+                double tiledMB = (double(groups) * double(tileBytes) + double(voxels)) * sizeof(cl_uchar4) / 1e6;
+
+                std::cout << "  " << std::left << std::setw(14) << c.name << std::right << std::fixed << std::setprecision(2)
+                          << refTime << "ms -> " << tiledTime << "ms, global reads " << refMB << "MB -> " << tiledMB << "MB\n";
+            }
+            std::cout << std::flush;
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Benchmark, " << e.what() << " : " << e.err() << '\n';
+        }
+    }
+
+    void Benchmark::pointwise(Device &device, cl_uint depth, cl_uint length, cl_uint width)
+    {
+        const std::vector<std::string> names = {"threshold", "invert", "contrast", "logTwo", "square", "fade", "colourise"};
+
+        std::size_t voxels = std::size_t(depth) * length * width;
+        std::vector<cl_uchar4> host = noise(voxels);
+
+        // Filter parameters after the buffers, the same positions in both forms.
+        auto params = [](Kernel &k, const std::string &name)
+        {
+            if (name == "threshold")
+            {
+                k.setArg(5, static_cast<cl_uchar>(0x80));
+            }
+            else if (name == "contrast")
+            {
+                k.setArg(5, static_cast<cl_uchar>(0x10));
+                k.setArg(6, static_cast<cl_uchar>(0xF0));
+            }
+            else if (name == "colourise")
+            {
+                for (unsigned int i = 0; i < 3; ++i)
+                    k.setArg(i + 5, 0.5f);
+            }
+        };
+
+        try
+        {
+            cl::Buffer in(device.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, voxels * sizeof(cl_uchar4), host.data());
+            cl::Buffer out(device.context, CL_MEM_WRITE_ONLY, voxels * sizeof(cl_uchar4));
+
+            auto rate = [&](Kernel &plain, const std::string &name)
+            {
+                Kernel &k = plain.pointwise(depth, length, width, 1);
+                k.setArg(3, in);
+                k.setArg(4, out);
+                params(k, name);
+                return static_cast<double>(voxels) / (static_cast<double>(measure(device, k)) * 1e3);
+            };
+
+            std::cout << "Pointwise benchmark, " << depth << 'x' << length << 'x' << width << ", Mvoxels/s per work-item span 1 / 16 / 64, * picked:\n";
+            describe(device);
+            for (const std::string &name : names)
+            {
+                auto &plain = device.programs.at("utility")->at(name);
+                auto wide = device.programs.at("utility")->at(name + "Wide");
+
+                // Detached while timing, whatever Device::initialise picked is put back after.
+                auto picked = plain->wide;
+                cl_uint span = wide->voxels;
+
+                plain->wide = nullptr;
+                double one = rate(*plain, name);
+
+                plain->wide = wide;
+                wide->voxels = 16;
+                double sixteen = rate(*plain, name);
+                wide->voxels = 64;
+                double sixtyFour = rate(*plain, name);
+
+                plain->wide = picked;
+                wide->voxels = span;
+
+                auto mark = [&](cl_uint n)
+                { return (picked ? picked->voxels : 1u) == n ? "*" : ""; };
+                std::cout << "  " << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(1)
+                          << one << mark(1) << " / " << sixteen << mark(16) << " / " << sixtyFour << mark(64) << '\n';
+            }
+            std::cout << std::flush;
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Benchmark, " << e.what() << " : " << e.err() << '\n';
+        }
+    }
+
+} // namespace opencl
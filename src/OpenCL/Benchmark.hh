@@ -0,0 +1,22 @@
+#ifndef OPENCL_BENCHMARK_HH
+#define OPENCL_BENCHMARK_HH
+
+#include <CL/cl2.hpp>
+
+#include "Device.hh"
+
+namespace opencl
+{
+
+    // Timings of the kernels on a synthetic volume, printed to stdout (--bench).
+    class Benchmark
+    {
+    public:
+        static void stencils(Device &device, cl_uint depth = 256, cl_uint length = 256, cl_uint width = 128);
+        // Voxels per second of each pointwise kernel, one voxel per work-item against the wide variants.
+        static void pointwise(Device &device, cl_uint depth = 256, cl_uint length = 256, cl_uint width = 128);
+    };
+
+} // namespace opencl
+
+#endif
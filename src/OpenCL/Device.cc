@@ -1,355 +1,460 @@
-#include "Device.hh"
-
-#include <filesystem>
-#include <iostream>
-#include <string>
-
-#include <gl/glew.h>
-#include <gl/gl.h>
-#include <gl/glext.h>
-
-#ifdef _WIN32
-#include <windows.h>
-#endif
-
-#include "Source.hh"
-#include "../GUI/Button.hh"
-
-namespace opencl
-{
-
-    Device::Device(unsigned int w, unsigned int h) : width(w), height(h)
-    {
-        // Rounds up to nearest multiple of 32 (for performance concerns)
-        width = width + 31 - (width + 31) % 32;
-        height = height + 31 - (height + 31) % 32;
-
-        // selectDevice();
-    }
-
-    Device::~Device()
-    {
-    }
-
-    void Device::initialise()
-    {
-        cQueue = cl::CommandQueue(context, device);
-
-        std::vector<cl::Device> devices{device};
-        std::string folder = "./filters/";
-        for (const auto &file : std::filesystem::directory_iterator(folder))
-        {
-            std::string name = file.path().string();
-            std::cout << "Found: " << name << std::endl;
-            Source src(file.path().string());
-
-            auto f = name.find_last_of('/');
-            programs.emplace(name.substr(f + 1, name.find_last_of('.') - f - 1), std::make_shared<Program>(context, src));
-            //, "-g -cl-opt-disable -s \"D:\\Documents\\Programming\\Uni\\Thesis\\filters\\raytracing.cl\"");
-        }
-
-        std::vector<uint32_t> clr;
-        clr.reserve(width * height);
-        std::fill_n(std::back_inserter(clr), width * height, 0);
-
-        glGenBuffers(1, &pixelBuffer);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
-        glBufferData(GL_PIXEL_UNPACK_BUFFER, width * height * sizeof(GLubyte) * 4, clr.data(), GL_STREAM_DRAW);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-
-        try
-        {
-            outBuffer = (type == CL_DEVICE_TYPE_GPU ? cl::BufferGL(context, CL_MEM_WRITE_ONLY, pixelBuffer) : cl::Buffer(context, CL_MEM_WRITE_ONLY, width * height * sizeof(cl_uint)));
-            // outBuffer = cl::Buffer(context, CL_MEM_WRITE_ONLY, width * height * sizeof(cl_uint));
-            invMVTransposed = cl::Buffer(context, CL_MEM_READ_ONLY, 12 * sizeof(float));
-
-            programs.at("raytracing")->at("render")->setArg(0, width);
-            programs.at("raytracing")->at("render")->setArg(1, height);
-            programs.at("raytracing")->at("render")->setArg(2, outBuffer);
-            programs.at("raytracing")->at("render")->setArg(7, invMVTransposed);
-        }
-        catch (const cl::Error &e)
-        {
-            std::cerr << "Display, " << e.what() << " : " << e.err() << '\n';
-            std::terminate();
-        }
-
-        GLenum err;
-        if ((err = glGetError()))
-            std::cout << "Pixel err: " << err << std::endl;
-    }
-
-    void Device::render(gui::Renderer &renderer)
-    {
-        cl::NDRange global(width, height);
-
-        if (renderer.tf->buffer.template getInfo<CL_MEM_SIZE>() != renderer.tf->length * renderer.tf->depth * renderer.tf->width * 4)
-        {
-            std::cerr << "Memory (" << renderer.tf->buffer.template getInfo<CL_MEM_SIZE>() << ") does not match volume memory footprint (" << renderer.tf->length * renderer.tf->depth * renderer.tf->width * 4 << ").\n";
-            std::terminate();
-        }
-
-        try
-        {
-            programs.at("raytracing")->at("render")->setArg(3, renderer.tf->depth);
-            programs.at("raytracing")->at("render")->setArg(4, renderer.tf->length);
-            programs.at("raytracing")->at("render")->setArg(5, renderer.tf->width);
-            programs.at("raytracing")->at("render")->setArg(6, renderer.tf->buffer);
-
-            cl_int err = 0;
-            if (type == CL_DEVICE_TYPE_GPU)
-            {
-                // Share GL buffer.
-                glFlush();
-                std::vector<cl::Memory> memories;
-                memories.push_back(outBuffer);
-                err |= cQueue.enqueueAcquireGLObjects(&memories);
-                err |= cQueue.enqueueWriteBuffer(invMVTransposed, CL_FALSE, 0, 12 * sizeof(float), renderer.inv.data());
-                err |= cQueue.enqueueNDRangeKernel(*programs.at("raytracing")->at("render"), cl::NullRange, global);
-                err |= cQueue.enqueueReleaseGLObjects(&memories);
-            }
-            else
-            {
-                // Copy via host.
-                err |= cQueue.enqueueWriteBuffer(invMVTransposed, CL_FALSE, 0, 12 * sizeof(float), renderer.inv.data());
-                err |= cQueue.enqueueNDRangeKernel(*programs.at("raytracing")->at("render"), cl::NullRange, global);
-                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
-                GLubyte *p = static_cast<GLubyte *>(glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
-                auto bSize = outBuffer.getInfo<CL_MEM_SIZE>();
-                err |= cQueue.enqueueReadBuffer(outBuffer, CL_TRUE, 0, bSize, p);
-                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-            }
-
-            err = cQueue.finish();
-
-            if (err != CL_SUCCESS)
-            {
-                std::cerr << "clFinish Error: " << err << '\n';
-                std::terminate();
-            }
-        }
-        catch (const cl::Error &e)
-        {
-            std::cerr << "Render, " << e.what() << " : " << e.err() << '\n';
-            std::terminate();
-        }
-    }
-
-    std::shared_ptr<gui::Tree> Device::buildDeviceTree(float x, float y)
-    {
-        std::shared_ptr<gui::Tree> dTree = gui::Tree::build("DEVICES");
-
-        std::vector<cl::Platform> platforms;
-        cl::Platform::get(&platforms);
-
-        for (const cl::Platform &p : platforms)
-        {
-            std::shared_ptr<gui::Tree> pTree = gui::Tree::build(p.getInfo<CL_PLATFORM_NAME>().c_str());
-
-            std::vector<cl::Device> devices;
-            p.getDevices(CL_DEVICE_TYPE_ALL, &devices);
-
-            for (const cl::Device &d : devices)
-            {
-                std::shared_ptr<gui::Button> dButton = gui::Button::build(d.getInfo<CL_DEVICE_NAME>().c_str());
-                dButton->onPress(
-                    [this, p, d]()
-                    {
-                        platform = p;
-                        device = d;
-                        selected = true;
-                        type = device.getInfo<CL_DEVICE_TYPE>();
-                        try
-                        {
-                            if (type == CL_DEVICE_TYPE_GPU)
-                            {
-#if defined(__APPLE__)
-                                CGLContextObj kCGLContext = CGLGetCurrentContext();
-                                CGLShareGroupObj kCGLShareGroup = CGLGetShareGroup(kCGLContext);
-                                cl_context_properties props[] =
-                                    {
-                                        CL_CONTEXT_PROPERTY_USE_CGL_SHAREGROUP_APPLE, (cl_context_properties)kCGLShareGroup,
-                                        0};
-#else
-#ifdef UNIX
-                                cl_context_properties props[] =
-                                    {
-                                        CL_GL_CONTEXT_KHR, (cl_context_properties)glXGetCurrentContext(),
-                                        CL_GLX_DISPLAY_KHR, (cl_context_properties)glXGetCurrentDisplay(),
-                                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
-                                        0};
-#else
-#ifdef _WIN32
-
-                                cl_context_properties props[] =
-                                    {
-                                        CL_GL_CONTEXT_KHR, (cl_context_properties)wglGetCurrentContext(),
-                                        CL_WGL_HDC_KHR, (cl_context_properties)wglGetCurrentDC(),
-                                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
-                                        0};
-#else
-#ifdef __ANDROID__
-                                cl_context_properties props[] =
-                                    {
-                                        CL_GL_CONTEXT_KHR, (cl_context_properties)eglGetCurrentContext(),
-                                        CL_EGL_DISPLAY_KHR, (cl_context_properties)eglGetCurrentDisplay(),
-                                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
-                                        0};
-#endif
-#endif
-#endif
-#endif
-
-                                context = cl::Context(device, props);
-                            }
-                            else
-                            {
-                                [[maybe_unused]] cl_context_properties props[] =
-                                    {
-                                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
-                                        0};
-                                context = cl::Context(device, props);
-                            }
-                        }
-                        catch (const cl::Error &e)
-                        {
-                            std::cerr << "Build Error, " << e.what() << " : " << e.err() << std::endl;
-                            std::terminate();
-                        }
-                        catch (const std::exception &e)
-                        {
-                            std::cerr << e.what() << '\n';
-                        }
-                    });
-                pTree->addLeaf(std::move(dButton));
-            }
-
-            dTree->addBranch(std::move(pTree));
-        }
-
-        dTree->resize(x, y, 0.0f, 0.0f);
-
-        return dTree;
-    }
-
-    void Device::selectDevice()
-    {
-        std::vector<cl::Platform> platforms;
-        cl::Platform::get(&platforms);
-
-        std::cout << "Select Platform:\n";
-
-        std::vector<std::string> names;
-        std::size_t i = 0;
-        for (const cl::Platform &p : platforms)
-        {
-            std::cout << '[' << i++ << "] " << p.getInfo<CL_PLATFORM_NAME>() << '\n';
-        }
-        std::cout << std::flush;
-
-        std::size_t n = 0;
-        do
-        {
-            std::cout << "Please enter a number: ";
-            while (!(std::cin >> n))
-            {
-                std::cin.clear();
-                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                std::cout << "Please enter a number: ";
-            }
-        } while (n >= i);
-
-        platform = platforms.at(n);
-
-        std::vector<cl::Device> devices;
-        platform.getDevices(CL_DEVICE_TYPE_ALL, &devices);
-
-        std::cout << "Select Device:\n";
-
-        names.clear();
-        i = 0;
-        for (const cl::Device &d : devices)
-        {
-            std::cout << '[' << i++ << "] " << d.getInfo<CL_DEVICE_NAME>() << '\n';
-        }
-        std::cout << std::flush;
-
-        n = 0;
-        do
-        {
-            std::cout << "Please enter a number: ";
-            while (!(std::cin >> n))
-            {
-                std::cin.clear();
-                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                std::cout << "Please enter a number: ";
-            }
-        } while (n >= i);
-
-        device = devices.at(n);
-
-        type = device.getInfo<CL_DEVICE_TYPE>();
-
-        try
-        {
-            if (type == CL_DEVICE_TYPE_GPU)
-            {
-#if defined(__APPLE__)
-                CGLContextObj kCGLContext = CGLGetCurrentContext();
-                CGLShareGroupObj kCGLShareGroup = CGLGetShareGroup(kCGLContext);
-                cl_context_properties props[] =
-                    {
-                        CL_CONTEXT_PROPERTY_USE_CGL_SHAREGROUP_APPLE, (cl_context_properties)kCGLShareGroup,
-                        0};
-#else
-#ifdef UNIX
-                cl_context_properties props[] =
-                    {
-                        CL_GL_CONTEXT_KHR, (cl_context_properties)glXGetCurrentContext(),
-                        CL_GLX_DISPLAY_KHR, (cl_context_properties)glXGetCurrentDisplay(),
-                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
-                        0};
-#else
-#ifdef _WIN32
-
-                cl_context_properties props[] =
-                    {
-                        CL_GL_CONTEXT_KHR, (cl_context_properties)wglGetCurrentContext(),
-                        CL_WGL_HDC_KHR, (cl_context_properties)wglGetCurrentDC(),
-                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
-                        0};
-#else
-#ifdef __ANDROID__
-                cl_context_properties props[] =
-                    {
-                        CL_GL_CONTEXT_KHR, (cl_context_properties)eglGetCurrentContext(),
-                        CL_EGL_DISPLAY_KHR, (cl_context_properties)eglGetCurrentDisplay(),
-                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
-                        0};
-#endif
-#endif
-#endif
-#endif
-
-                context = cl::Context(device, props);
-            }
-            else
-            {
-                [[maybe_unused]] cl_context_properties props[] =
-                    {
-                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
-                        0};
-                context = cl::Context(device, props);
-            }
-        }
-        catch (const cl::Error &e)
-        {
-            std::cerr << "Build Error, " << e.what() << " : " << e.err() << std::endl;
-            std::terminate();
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << e.what() << '\n';
-        }
-    }
+#include "Device.hh"
+
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gl/glew.h>
+#include <gl/gl.h>
+#include <gl/glext.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "Arena.hh"
+#include "Source.hh"
+#include "Tuner.hh"
+#include "../GUI/Button.hh"
+#include "../Native/Kernels.hh"
+
+namespace opencl
+{
+
+    bool Device::wideKernels = true;
+
+    Device::Device(unsigned int w, unsigned int h) : width(w), height(h)
+    {
+        // Rounds up to nearest multiple of 32 (for performance concerns)
+        width = width + 31 - (width + 31) % 32;
+        height = height + 31 - (height + 31) % 32;
+
+        // selectDevice();
+    }
+
+    Device::Device(const cl::Platform &p, const cl::Device &d) : platform(p), device(d)
+    {
+        // Headless device (see DeviceGroup), no GL sharing so a plain platform context will do.
+        type = device.getInfo<CL_DEVICE_TYPE>();
+        selected = true;
+
+        try
+        {
+            cl_context_properties props[] =
+                {
+                    CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                    0};
+            context = cl::Context(device, props);
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Build Error, " << e.what() << " : " << e.err() << std::endl;
+            std::terminate();
+        }
+    }
+
+    Device::~Device()
+    {
+    }
+
+    std::map<std::string, std::shared_ptr<Program>> Device::loadPrograms(const cl::Context &context)
+    {
+        std::map<std::string, std::shared_ptr<Program>> progs;
+        std::vector<std::pair<std::string, std::future<std::shared_ptr<Program>>>> builds;
+
+        // Programs are independent, build (or load from the binary cache) them all at once.
+        std::string folder = "./filters/";
+        for (const auto &file : std::filesystem::directory_iterator(folder))
+        {
+            std::string name = file.path().string();
+            std::cout << "Found: " << name << std::endl;
+
+            auto f = name.find_last_of('/');
+            builds.emplace_back(name.substr(f + 1, name.find_last_of('.') - f - 1), std::async(std::launch::async, [context, name]()
+                                                                                               { return std::make_shared<Program>(context, Source(name)); }));
+            //, "-g -cl-opt-disable -s \"D:\\Documents\\Programming\\Uni\\Thesis\\filters\\raytracing.cl\"");
+        }
+
+        for (auto &[name, build] : builds)
+        {
+            progs.emplace(name, build.get());
+        }
+
+        return progs;
+    }
+
+    void Device::initialise(bool display)
+    {
+        if (!native)
+        {
+            cQueue = cl::CommandQueue(context, device);
+            maxAlloc = device.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>();
+
+            programs = loadPrograms(context);
+
+            // CPU devices take the pointwise kernels wide, 4 voxels per uchar16 op and 16 voxels a work-item, 64
+            // where the preferred char vector is 256 bits or more.
+            if (wideKernels && type == CL_DEVICE_TYPE_CPU && programs.contains("utility"))
+            {
+                cl_uint voxels = device.getInfo<CL_DEVICE_PREFERRED_VECTOR_WIDTH_CHAR>() >= 32 ? 64 : 16;
+                auto &kernels = programs.at("utility")->kernels;
+                for (auto &[name, k] : kernels)
+                {
+                    auto itr = kernels.find(name + "Wide");
+                    if (itr != kernels.end())
+                    {
+                        k->wide = itr->second;
+                        k->wide->voxels = voxels;
+                    }
+                }
+                std::cout << "Wide pointwise kernels, " << voxels << " voxels per work-item" << std::endl;
+            }
+        }
+
+        if (!display)
+            return;
+
+        std::vector<uint32_t> clr;
+        clr.reserve(width * height);
+        std::fill_n(std::back_inserter(clr), width * height, 0);
+
+        glGenBuffers(1, &pixelBuffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, width * height * sizeof(GLubyte) * 4, clr.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        // The host renderer writes straight into the pixel buffer
+        if (native)
+            return;
+
+        try
+        {
+            outBuffer = (type == CL_DEVICE_TYPE_GPU ? cl::BufferGL(context, CL_MEM_WRITE_ONLY, pixelBuffer) : Arena::allocate(context, width * height * sizeof(cl_uint)));
+            // outBuffer = cl::Buffer(context, CL_MEM_WRITE_ONLY, width * height * sizeof(cl_uint));
+            invMVTransposed = Arena::allocate(context, 12 * sizeof(float));
+
+            for (const char *name : {"render", "renderPolar", "renderImage", "renderPolarImage"})
+            {
+                programs.at("raytracing")->at(name)->setArg(0, width);
+                programs.at("raytracing")->at(name)->setArg(1, height);
+                programs.at("raytracing")->at(name)->setArg(2, outBuffer);
+                programs.at("raytracing")->at(name)->setArg(7, invMVTransposed);
+            }
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Display, " << e.what() << " : " << e.err() << '\n';
+            std::terminate();
+        }
+
+        GLenum err;
+        if ((err = glGetError()))
+            std::cout << "Pixel err: " << err << std::endl;
+    }
+
+    void Device::render(gui::Renderer &renderer)
+    {
+        // Polar rendering needs the fan geometry, a volume without it renders as it is.
+        bool polar = renderer.polar && renderer.tf->delta > 0.0f;
+
+        if (native)
+        {
+            // Raymarched on the host, copied up like the CPU device path.
+            std::vector<cl_uint> pixels(static_cast<std::size_t>(width) * height);
+            native::Shape shape = {renderer.tf->depth, renderer.tf->length, renderer.tf->width};
+            if (polar)
+                native::renderPolar(width, height, pixels, shape, renderer.tf->host(), renderer.inv, renderer.tf->ratio, renderer.tf->delta);
+            else
+                native::render(width, height, pixels, shape, renderer.tf->host(), renderer.inv);
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+            glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(pixels.size() * sizeof(cl_uint)), pixels.data());
+            return;
+        }
+
+        cl::NDRange global(width, height);
+
+        if (renderer.tf->buffer.template getInfo<CL_MEM_SIZE>() != renderer.tf->length * renderer.tf->depth * renderer.tf->width * 4)
+        {
+            std::cerr << "Memory (" << renderer.tf->buffer.template getInfo<CL_MEM_SIZE>() << ") does not match volume memory footprint (" << renderer.tf->length * renderer.tf->depth * renderer.tf->width * 4 << ").\n";
+            std::terminate();
+        }
+
+        try
+        {
+            // Filtered image reads where the device supports them, nearest voxel from the buffer otherwise.
+            bool image = renderer.tf->toImage(context, cQueue);
+            Kernel &kernel = *programs.at("raytracing")->at(std::string(polar ? "renderPolar" : "render") + (image ? "Image" : ""));
+
+            kernel.setArg(3, renderer.tf->depth);
+            kernel.setArg(4, renderer.tf->length);
+            kernel.setArg(5, renderer.tf->width);
+            if (image)
+                kernel.setArg(6, renderer.tf->image);
+            else
+                kernel.setArg(6, renderer.tf->buffer);
+            if (polar)
+            {
+                kernel.setArg(8, renderer.tf->ratio);
+                kernel.setArg(9, renderer.tf->delta);
+            }
+
+            cl_int err = 0;
+            if (type == CL_DEVICE_TYPE_GPU)
+            {
+                // Share GL buffer.
+                glFlush();
+                std::vector<cl::Memory> memories;
+                memories.push_back(outBuffer);
+                err |= cQueue.enqueueAcquireGLObjects(&memories);
+                err |= cQueue.enqueueWriteBuffer(invMVTransposed, CL_FALSE, 0, 12 * sizeof(float), renderer.inv.data());
+                err |= cQueue.enqueueNDRangeKernel(kernel, cl::NullRange, global, Tuner::local(kernel, cQueue, global));
+                err |= cQueue.enqueueReleaseGLObjects(&memories);
+            }
+            else
+            {
+                // Copy via host.
+                err |= cQueue.enqueueWriteBuffer(invMVTransposed, CL_FALSE, 0, 12 * sizeof(float), renderer.inv.data());
+                err |= cQueue.enqueueNDRangeKernel(kernel, cl::NullRange, global, Tuner::local(kernel, cQueue, global));
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+                GLubyte *p = static_cast<GLubyte *>(glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+                auto bSize = outBuffer.getInfo<CL_MEM_SIZE>();
+                err |= cQueue.enqueueReadBuffer(outBuffer, CL_TRUE, 0, bSize, p);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+
+            err = cQueue.finish();
+
+            if (err != CL_SUCCESS)
+            {
+                std::cerr << "clFinish Error: " << err << '\n';
+                std::terminate();
+            }
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Render, " << e.what() << " : " << e.err() << '\n';
+            std::terminate();
+        }
+    }
+
+    std::shared_ptr<gui::Tree> Device::buildDeviceTree(float x, float y)
+    {
+        std::shared_ptr<gui::Tree> dTree = gui::Tree::build("DEVICES");
+
+        std::vector<cl::Platform> platforms;
+        cl::Platform::get(&platforms);
+
+        for (const cl::Platform &p : platforms)
+        {
+            std::shared_ptr<gui::Tree> pTree = gui::Tree::build(p.getInfo<CL_PLATFORM_NAME>().c_str());
+
+            std::vector<cl::Device> devices;
+            p.getDevices(CL_DEVICE_TYPE_ALL, &devices);
+
+            for (const cl::Device &d : devices)
+            {
+                std::shared_ptr<gui::Button> dButton = gui::Button::build(d.getInfo<CL_DEVICE_NAME>().c_str());
+                dButton->onPress(
+                    [this, p, d]()
+                    {
+                        platform = p;
+                        device = d;
+                        selected = true;
+                        type = device.getInfo<CL_DEVICE_TYPE>();
+                        try
+                        {
+                            if (type == CL_DEVICE_TYPE_GPU)
+                            {
+#if defined(__APPLE__)
+                                CGLContextObj kCGLContext = CGLGetCurrentContext();
+                                CGLShareGroupObj kCGLShareGroup = CGLGetShareGroup(kCGLContext);
+                                cl_context_properties props[] =
+                                    {
+                                        CL_CONTEXT_PROPERTY_USE_CGL_SHAREGROUP_APPLE, (cl_context_properties)kCGLShareGroup,
+                                        0};
+#else
+#ifdef UNIX
+                                cl_context_properties props[] =
+                                    {
+                                        CL_GL_CONTEXT_KHR, (cl_context_properties)glXGetCurrentContext(),
+                                        CL_GLX_DISPLAY_KHR, (cl_context_properties)glXGetCurrentDisplay(),
+                                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                                        0};
+#else
+#ifdef _WIN32
+
+                                cl_context_properties props[] =
+                                    {
+                                        CL_GL_CONTEXT_KHR, (cl_context_properties)wglGetCurrentContext(),
+                                        CL_WGL_HDC_KHR, (cl_context_properties)wglGetCurrentDC(),
+                                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                                        0};
+#else
+#ifdef __ANDROID__
+                                cl_context_properties props[] =
+                                    {
+                                        CL_GL_CONTEXT_KHR, (cl_context_properties)eglGetCurrentContext(),
+                                        CL_EGL_DISPLAY_KHR, (cl_context_properties)eglGetCurrentDisplay(),
+                                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                                        0};
+#endif
+#endif
+#endif
+#endif
+
+                                context = cl::Context(device, props);
+                            }
+                            else
+                            {
+                                [[maybe_unused]] cl_context_properties props[] =
+                                    {
+                                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                                        0};
+                                context = cl::Context(device, props);
+                            }
+                        }
+                        catch (const cl::Error &e)
+                        {
+                            std::cerr << "Build Error, " << e.what() << " : " << e.err() << std::endl;
+                            std::terminate();
+                        }
+                        catch (const std::exception &e)
+                        {
+                            std::cerr << e.what() << '\n';
+                        }
+                    });
+                pTree->addLeaf(std::move(dButton));
+            }
+
+            dTree->addBranch(std::move(pTree));
+        }
+
+        dTree->resize(x, y, 0.0f, 0.0f);
+
+        return dTree;
+    }
+
+    void Device::selectDevice()
+    {
+        std::vector<cl::Platform> platforms;
+        cl::Platform::get(&platforms);
+
+        std::cout << "Select Platform:\n";
+
+        std::vector<std::string> names;
+        std::size_t i = 0;
+        for (const cl::Platform &p : platforms)
+        {
+            std::cout << '[' << i++ << "] " << p.getInfo<CL_PLATFORM_NAME>() << '\n';
+        }
+        std::cout << std::flush;
+
+        std::size_t n = 0;
+        do
+        {
+            std::cout << "Please enter a number: ";
+            while (!(std::cin >> n))
+            {
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Please enter a number: ";
+            }
+        } while (n >= i);
+
+        platform = platforms.at(n);
+
+        std::vector<cl::Device> devices;
+        platform.getDevices(CL_DEVICE_TYPE_ALL, &devices);
+
+        std::cout << "Select Device:\n";
+
+        names.clear();
+        i = 0;
+        for (const cl::Device &d : devices)
+        {
+            std::cout << '[' << i++ << "] " << d.getInfo<CL_DEVICE_NAME>() << '\n';
+        }
+        std::cout << std::flush;
+
+        n = 0;
+        do
+        {
+            std::cout << "Please enter a number: ";
+            while (!(std::cin >> n))
+            {
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Please enter a number: ";
+            }
+        } while (n >= i);
+
+        device = devices.at(n);
+
+        type = device.getInfo<CL_DEVICE_TYPE>();
+
+        try
+        {
+            if (type == CL_DEVICE_TYPE_GPU)
+            {
+#if defined(__APPLE__)
+                CGLContextObj kCGLContext = CGLGetCurrentContext();
+                CGLShareGroupObj kCGLShareGroup = CGLGetShareGroup(kCGLContext);
+                cl_context_properties props[] =
+                    {
+                        CL_CONTEXT_PROPERTY_USE_CGL_SHAREGROUP_APPLE, (cl_context_properties)kCGLShareGroup,
+                        0};
+#else
+#ifdef UNIX
+                cl_context_properties props[] =
+                    {
+                        CL_GL_CONTEXT_KHR, (cl_context_properties)glXGetCurrentContext(),
+                        CL_GLX_DISPLAY_KHR, (cl_context_properties)glXGetCurrentDisplay(),
+                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                        0};
+#else
+#ifdef _WIN32
+
+                cl_context_properties props[] =
+                    {
+                        CL_GL_CONTEXT_KHR, (cl_context_properties)wglGetCurrentContext(),
+                        CL_WGL_HDC_KHR, (cl_context_properties)wglGetCurrentDC(),
+                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                        0};
+#else
+#ifdef __ANDROID__
+                cl_context_properties props[] =
+                    {
+                        CL_GL_CONTEXT_KHR, (cl_context_properties)eglGetCurrentContext(),
+                        CL_EGL_DISPLAY_KHR, (cl_context_properties)eglGetCurrentDisplay(),
+                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                        0};
+#endif
+#endif
+#endif
+#endif
+
+                context = cl::Context(device, props);
+            }
+            else
+            {
+                [[maybe_unused]] cl_context_properties props[] =
+                    {
+                        CL_CONTEXT_PLATFORM, (cl_context_properties)platform(),
+                        0};
+                context = cl::Context(device, props);
+            }
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Build Error, " << e.what() << " : " << e.err() << std::endl;
+            std::terminate();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << e.what() << '\n';
+        }
+    }
 } // namespace opencl
\ No newline at end of file
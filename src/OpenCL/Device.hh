@@ -1,60 +1,67 @@
-#ifndef GUI_OPENCL_DEVICE
-#define GUI_OPENCL_DEVICE
-
-#include <chrono>
-#include <map>
-#include <memory>
-#include <string>
-#include <vector>
-
-#include <gl/glew.h>
-#include <gl/gl.h>
-#include <gl/glext.h>
-
-#include <CL/cl2.hpp>
-
-#include <SDL2/SDL_timer.h>
-
-#include "Program.hh"
-#include "Concepts.hh"
-
-#include "../GUI/Renderer.hh"
-#include "../GUI/Rectangle.hh"
-#include "../GUI/Tree.hh"
-
-namespace opencl
-{
-
-    class Device
-    {
-    private:
-        cl::Platform platform;
-        cl::Device device;
-        cl::Buffer outBuffer;
-        cl::Buffer invMVTransposed;
-
-        unsigned int width = 0;
-        unsigned int height = 0;
-
-    public:
-        cl_GLuint pixelBuffer;
-        cl::CommandQueue cQueue;
-
-        std::map<std::string, std::shared_ptr<Program>> programs;
-        cl::Context context;
-        cl_device_type type = CL_DEVICE_TYPE_CPU;
-
-        bool selected = false;
-
-        Device(unsigned int width = 512, unsigned int height = 512);
-        ~Device();
-
-        void initialise();
-        void render(gui::Renderer &renderer);
-        void createDisplay(unsigned int w, unsigned int h);
-        std::shared_ptr<gui::Tree> buildDeviceTree(float x = 0.0f, float y = 0.0f);
-        void selectDevice();
-    };
-
-} // namespace opencl
+#ifndef GUI_OPENCL_DEVICE
+#define GUI_OPENCL_DEVICE
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gl/glew.h>
+#include <gl/gl.h>
+#include <gl/glext.h>
+
+#include <CL/cl2.hpp>
+
+#include <SDL2/SDL_timer.h>
+
+#include "Program.hh"
+#include "Concepts.hh"
+
+#include "../GUI/Renderer.hh"
+#include "../GUI/Rectangle.hh"
+#include "../GUI/Tree.hh"
+
+namespace opencl
+{
+
+    class Device
+    {
+    private:
+        cl::Platform platform;
+        cl::Device device;
+        cl::Buffer outBuffer;
+        cl::Buffer invMVTransposed;
+
+        unsigned int width = 0;
+        unsigned int height = 0;
+
+    public:
+        static bool wideKernels; // false (--no-wide) keeps CPU devices on the one voxel per work-item kernels
+
+        cl_GLuint pixelBuffer;
+        cl::CommandQueue cQueue;
+
+        std::map<std::string, std::shared_ptr<Program>> programs;
+        cl::Context context;
+        cl_device_type type = CL_DEVICE_TYPE_CPU;
+        cl_ulong maxAlloc = 0; // CL_DEVICE_MAX_MEM_ALLOC_SIZE, larger frames are exported in slabs
+
+        bool selected = false;
+        bool native = false; // No OpenCL platform, filters and rendering run on the host (src/Native)
+
+        Device(unsigned int width = 512, unsigned int height = 512);
+        Device(const cl::Platform &p, const cl::Device &d);
+        ~Device();
+
+        static std::map<std::string, std::shared_ptr<Program>> loadPrograms(const cl::Context &context);
+
+        void initialise(bool display = true);
+        void render(gui::Renderer &renderer);
+        void createDisplay(unsigned int w, unsigned int h);
+        std::shared_ptr<gui::Tree> buildDeviceTree(float x = 0.0f, float y = 0.0f);
+        void selectDevice();
+    };
+
+} // namespace opencl
 #endif
\ No newline at end of file
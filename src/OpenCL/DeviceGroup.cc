@@ -0,0 +1,50 @@
+#include "DeviceGroup.hh"
+
+#include <iostream>
+
+namespace opencl
+{
+
+    void DeviceGroup::select(cl_device_type mask)
+    {
+        devices.clear();
+
+        std::vector<cl::Platform> platforms;
+        cl::Platform::get(&platforms);
+
+        for (const cl::Platform &p : platforms)
+        {
+            std::vector<cl::Device> pDevices;
+            try
+            {
+                p.getDevices(mask, &pDevices);
+            }
+            catch (const cl::Error &e)
+            {
+                // CL_DEVICE_NOT_FOUND, platform has nothing of the requested type.
+                continue;
+            }
+
+            for (const cl::Device &d : pDevices)
+            {
+                std::cout << "Group: " << p.getInfo<CL_PLATFORM_NAME>() << " / " << d.getInfo<CL_DEVICE_NAME>() << '\n';
+                devices.push_back(std::make_shared<Device>(p, d));
+            }
+        }
+        std::cout << std::flush;
+    }
+
+    void DeviceGroup::initialise()
+    {
+        for (auto &d : devices)
+        {
+            d->initialise(false);
+        }
+    }
+
+    bool DeviceGroup::empty() const
+    {
+        return devices.empty();
+    }
+
+} // namespace opencl
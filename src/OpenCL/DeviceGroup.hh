@@ -0,0 +1,153 @@
+#ifndef OPENCL_DEVICEGROUP_HH
+#define OPENCL_DEVICEGROUP_HH
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <CL/cl2.hpp>
+
+#include "Device.hh"
+
+namespace opencl
+{
+
+    class DeviceGroup
+    {
+    public:
+        enum class Schedule
+        {
+            RoundRobin,
+            WorkStealing
+        };
+
+        std::vector<std::shared_ptr<Device>> devices;
+        Schedule schedule = Schedule::WorkStealing;
+
+        DeviceGroup() = default;
+        ~DeviceGroup() = default;
+
+        void select(cl_device_type mask = CL_DEVICE_TYPE_CPU | CL_DEVICE_TYPE_ACCELERATOR);
+        void initialise();
+
+        bool empty() const;
+
+        // Runs job(device index, frame) for every frame on one thread per device, sink(frame, result) is
+        // called on the calling thread strictly in frame order as results become available. The first exception
+        // thrown by a job stops the remaining devices and is rethrown here once the workers have joined.
+        template <typename Job, typename Sink>
+        void process(cl_uint frames, Job job, Sink sink)
+        {
+            using result_t = std::invoke_result_t<Job, std::size_t, cl_uint>;
+
+            std::size_t n = devices.size();
+            if (n == 0 || frames == 0)
+                return;
+
+            // Frames are dealt round-robin, with work stealing idle devices take from the back of another queue.
+            std::vector<std::deque<cl_uint>> queues(n);
+            std::vector<std::mutex> locks(n);
+            for (cl_uint f = 0; f < frames; ++f)
+            {
+                queues[f % n].push_back(f);
+            }
+
+            auto next = [&](std::size_t d, cl_uint &f)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(locks[d]);
+                    if (!queues[d].empty())
+                    {
+                        f = queues[d].front();
+                        queues[d].pop_front();
+                        return true;
+                    }
+                }
+
+                if (schedule == Schedule::RoundRobin)
+                    return false;
+
+                for (std::size_t i = 1; i < n; ++i)
+                {
+                    std::size_t v = (d + i) % n;
+                    std::lock_guard<std::mutex> lock(locks[v]);
+                    if (!queues[v].empty())
+                    {
+                        f = queues[v].back();
+                        queues[v].pop_back();
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            std::mutex doneLock;
+            std::condition_variable doneCv;
+            std::map<cl_uint, result_t> done;
+            std::exception_ptr error;
+
+            std::vector<std::thread> workers;
+            workers.reserve(n);
+            for (std::size_t d = 0; d < n; ++d)
+            {
+                workers.emplace_back(
+                    [&, d]()
+                    {
+                        cl_uint f;
+                        while (next(d, f))
+                        {
+                            try
+                            {
+                                result_t r = job(d, f);
+                                std::lock_guard<std::mutex> lock(doneLock);
+                                if (error)
+                                    break;
+                                done.emplace(f, std::move(r));
+                            }
+                            catch (...)
+                            {
+                                std::lock_guard<std::mutex> lock(doneLock);
+                                if (!error)
+                                    error = std::current_exception();
+                                break;
+                            }
+                            doneCv.notify_one();
+                        }
+                        doneCv.notify_one();
+                    });
+            }
+
+            // Gather in order for the writers.
+            for (cl_uint f = 0; f < frames; ++f)
+            {
+                std::unique_lock<std::mutex> lock(doneLock);
+                doneCv.wait(lock, [&]()
+                            { return done.contains(f) || error; });
+                if (error)
+                    break;
+                result_t r = std::move(done.at(f));
+                done.erase(f);
+                lock.unlock();
+
+                sink(f, std::move(r));
+            }
+
+            for (auto &w : workers)
+            {
+                w.join();
+            }
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+    };
+
+} // namespace opencl
+
+#endif
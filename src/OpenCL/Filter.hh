@@ -1,30 +1,43 @@
-#ifndef OPENCL_FILTER
-#define OPENCL_FILTER
-
-#include <functional>
-#include <memory>
-
-#include "../GUI/Tree.hh"
-#include "../Data/Volume.hh"
-
-namespace opencl
-{
-    class Filter
-    {
-    protected:
-        Filter() = default;
-        ~Filter() = default;
-
-    public:
-        bool toggle = true;
-        std::shared_ptr<data::Volume> volume;
-        std::function<void(const std::weak_ptr<data::Volume> &)> input;
-        std::function<void(void)> execute;
-        std::function<std::shared_ptr<gui::Tree>(void)> getOptions;
-        std::function<bool(const char *)> load = [](const char *)
-        { return false; };
-    };
-
-} // namespace opencl
-
+#ifndef OPENCL_FILTER
+#define OPENCL_FILTER
+
+#include <functional>
+#include <memory>
+
+#include "../GUI/Tree.hh"
+#include "../Data/Volume.hh"
+
+namespace opencl
+{
+    class Device;
+
+    class Filter
+    {
+    protected:
+        Filter() = default;
+        Filter(const cl::CommandQueue &q) : queue(q) {}
+        ~Filter() = default;
+
+    public:
+        bool toggle = true;
+        // Everything the filter enqueues goes here, the device's queue unless gui::Kernel::execute gives the
+        // node's branch one of its own. Null for host filters.
+        cl::CommandQueue queue;
+        std::shared_ptr<data::Volume> volume;
+        std::function<void(const std::weak_ptr<data::Volume> &)> input;
+        std::function<void(void)> execute;
+        std::function<std::shared_ptr<gui::Tree>(void)> getOptions;
+        std::function<bool(const char *)> load = [](const char *)
+        { return false; };
+        // Builds an equivalent filter (sharing options) on another device, empty if it can't be moved.
+        std::function<std::shared_ptr<Filter>(const Device &)> replicate;
+        // Planes past each z end of a slab the output depends on, empty when it needs the whole volume (see
+        // gui::Kernel::exportKernels).
+        std::function<cl_uint(void)> halo;
+        // Device bytes held per voxel, output and scratch, empty for a uchar4 output alone.
+        std::function<std::size_t(void)> footprint;
+    };
+
+} // namespace opencl
+
 #endif
\ No newline at end of file
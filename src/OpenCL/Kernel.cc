@@ -1,68 +1,167 @@
-#include "Kernel.hh"
-
-#include <CL/cl2.hpp>
-
-namespace opencl
-{
-
-    Kernel::Kernel(cl::Kernel k) : kernel(k)
-    {
-    }
-
-    Kernel::~Kernel()
-    {
-    }
-
-    Kernel::operator cl::Kernel()
-    {
-        return kernel;
-    }
-
-    std::string Kernel::getArg(unsigned int pos)
-    {
-        return kernel.getArgInfo<CL_KERNEL_ARG_NAME>(pos);
-    }
-
-    bool Kernel::isInput(unsigned int pos)
-    {
-        auto addr = kernel.getArgInfo<CL_KERNEL_ARG_ADDRESS_QUALIFIER>(pos);
-        auto acce = kernel.getArgInfo<CL_KERNEL_ARG_ACCESS_QUALIFIER>(pos);
-
-        return (addr == CL_KERNEL_ARG_ADDRESS_CONSTANT || acce != CL_KERNEL_ARG_ACCESS_WRITE_ONLY);
-    }
-
-    bool Kernel::isOutput(unsigned int pos)
-    {
-        auto addr = kernel.getArgInfo<CL_KERNEL_ARG_ADDRESS_QUALIFIER>(pos);
-        auto acce = kernel.getArgInfo<CL_KERNEL_ARG_ACCESS_QUALIFIER>(pos);
-
-        return (addr != CL_KERNEL_ARG_ADDRESS_CONSTANT && (acce == CL_KERNEL_ARG_ACCESS_WRITE_ONLY || acce == CL_KERNEL_ARG_ACCESS_READ_WRITE));
-    }
-
-    cl_uint Kernel::numArgs()
-    {
-        return kernel.getInfo<CL_KERNEL_NUM_ARGS>();
-    }
-
-    void Kernel::execute(cl::CommandQueue &cQueue)
-    {
-        try
-        {
-            cl_int err = 0;
-
-            err |= cQueue.enqueueNDRangeKernel(kernel, cl::NullRange, global);
-
-            if (err != CL_SUCCESS)
-            {
-                std::cerr << err << '\n';
-                std::terminate();
-            }
-        }
-        catch (const cl::Error &e)
-        {
-            std::cerr << "Finish, " << e.what() << " : " << e.err() << '\n';
-            std::terminate();
-        }
-    }
-
-} // namespace opencl
+#include "Kernel.hh"
+
+#include <CL/cl2.hpp>
+
+#include "Program.hh"
+#include "Tuner.hh"
+
+namespace opencl
+{
+
+    Kernel::Kernel(cl::Kernel k, std::vector<Arg> info, Program *owner) : generic(k), function(k.getInfo<CL_KERNEL_FUNCTION_NAME>()), kernel(k), program(owner), table(std::move(info))
+    {
+        if (!table.empty())
+            return;
+
+        try
+        {
+            cl_uint n = k.getInfo<CL_KERNEL_NUM_ARGS>();
+            table.reserve(n);
+            for (cl_uint i = 0; i < n; ++i)
+            {
+                table.push_back({k.getArgInfo<CL_KERNEL_ARG_NAME>(i),
+                                 k.getArgInfo<CL_KERNEL_ARG_TYPE_NAME>(i),
+                                 k.getArgInfo<CL_KERNEL_ARG_ADDRESS_QUALIFIER>(i),
+                                 k.getArgInfo<CL_KERNEL_ARG_ACCESS_QUALIFIER>(i)});
+            }
+        }
+        catch (const cl::Error &e)
+        {
+            // CL_KERNEL_ARG_INFO_NOT_AVAILABLE
+            table.clear();
+        }
+    }
+
+    Kernel::~Kernel()
+    {
+    }
+
+    Kernel::operator cl::Kernel()
+    {
+        return kernel;
+    }
+
+    const std::string &Kernel::name() const
+    {
+        return function;
+    }
+
+    const std::vector<Kernel::Arg> &Kernel::args() const
+    {
+        return table;
+    }
+
+    std::string Kernel::getArg(unsigned int pos)
+    {
+        return pos < table.size() ? table[pos].name : std::string();
+    }
+
+    bool Kernel::isInput(unsigned int pos)
+    {
+        if (pos >= table.size())
+            return false;
+
+        auto addr = table[pos].address;
+        auto acce = table[pos].access;
+
+        return (addr == CL_KERNEL_ARG_ADDRESS_CONSTANT || acce != CL_KERNEL_ARG_ACCESS_WRITE_ONLY);
+    }
+
+    bool Kernel::isOutput(unsigned int pos)
+    {
+        if (pos >= table.size())
+            return false;
+
+        auto addr = table[pos].address;
+        auto acce = table[pos].access;
+
+        return (addr != CL_KERNEL_ARG_ADDRESS_CONSTANT && (acce == CL_KERNEL_ARG_ACCESS_WRITE_ONLY || acce == CL_KERNEL_ARG_ACCESS_READ_WRITE));
+    }
+
+    cl_uint Kernel::numArgs()
+    {
+        return generic.getInfo<CL_KERNEL_NUM_ARGS>();
+    }
+
+    void Kernel::specialise(cl_uint depth, cl_uint length, cl_uint width)
+    {
+        std::array<cl_uint, 3> s = {depth, length, width};
+        if (s == shape || !program)
+            return;
+        shape = s;
+
+        cl::Kernel k = program->variant(function, depth, length, width);
+        kernel = k() ? k : generic;
+        maxGroup = 0;
+    }
+
+    Kernel &Kernel::pointwise(cl_uint depth, cl_uint length, cl_uint width, cl_uint batch)
+    {
+        if (!wide)
+        {
+            specialise(depth, length, width);
+            setArg(0, depth);
+            setArg(1, length);
+            setArg(2, width);
+            global = cl::NDRange(depth, length, width * batch);
+            return *this;
+        }
+
+        cl_uint count = depth * length * width * batch;
+        cl_uint n = wide->numArgs();
+        wide->setArg(0, depth);
+        wide->setArg(1, length);
+        wide->setArg(2, width);
+        wide->setArg(n - 2, count);
+        wide->setArg(n - 1, wide->voxels);
+        wide->global = cl::NDRange((count + wide->voxels - 1) / wide->voxels);
+        return *wide;
+    }
+
+    std::size_t Kernel::tile(cl::CommandQueue &cQueue, cl_uint depth, cl_uint length, cl_uint width, cl_uint batch, cl_uint r)
+    {
+        if (maxGroup == 0)
+            maxGroup = kernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(cQueue.getInfo<CL_QUEUE_DEVICE>());
+
+        std::size_t x = 8, y = 8, z = width == 1 ? 1 : 4;
+        while (x * y * z > maxGroup)
+        {
+            if (z > 1)
+                z /= 2;
+            else if (y > 1)
+                y /= 2;
+            else
+                x /= 2;
+        }
+
+        auto roundUp = [](std::size_t n, std::size_t m)
+        { return (n + m - 1) / m * m; };
+
+        local = cl::NDRange(x, y, z);
+        global = cl::NDRange(roundUp(depth, x), roundUp(length, y), roundUp(width, z) * batch);
+
+        return (x + 2 * r) * (y + 2 * r) * (z + 2 * r) * sizeof(cl_uchar);
+    }
+
+    void Kernel::execute(cl::CommandQueue &cQueue)
+    {
+        try
+        {
+            cl_int err = 0;
+
+            err |= cQueue.enqueueNDRangeKernel(kernel, cl::NullRange, global, local.dimensions() ? local : Tuner::local(*this, cQueue, global));
+
+            if (err != CL_SUCCESS)
+            {
+                std::cerr << err << '\n';
+                std::terminate();
+            }
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Finish, " << e.what() << " : " << e.err() << '\n';
+            std::terminate();
+        }
+    }
+
+} // namespace opencl
@@ -1,83 +1,147 @@
-#ifndef OPENCL_KERNEL_HH
-#define OPENCL_KERNEL_HH
-
-#include <cctype>
-#include <iostream>
-#include <string>
-
-#include "Concepts.hh"
-
-#include <CL\cl2.hpp>
-
-namespace opencl
-{
-
-    class Kernel
-    {
-    private:
-        cl::Kernel kernel;
-
-    public:
-        Kernel(cl::Kernel kernel);
-        ~Kernel();
-
-        operator cl::Kernel();
-
-        cl::NDRange global;
-
-        std::string getArg(unsigned int pos);
-        bool isInput(unsigned int pos);
-        bool isOutput(unsigned int pos);
-
-        cl_uint numArgs();
-
-        template <concepts::OpenCLType T>
-        void setArg(unsigned int pos, T t, std::size_t size = 0)
-        {
-            if constexpr (concepts::OpenCLScalarType<T>)
-            {
-                std::string name = kernel.getArgInfo<CL_KERNEL_ARG_TYPE_NAME>(pos);
-                if (!std::isalpha(name.back()))
-                {
-                    std::cout << kernel.getArgInfo<CL_KERNEL_ARG_TYPE_NAME>(pos) << " is not a scalar type." << std::endl;
-                    return;
-                }
-                kernel.setArg(pos, t);
-            }
-            else if constexpr (concepts::OpenCLVectorType<T>)
-            {
-                std::string name = kernel.getArgInfo<CL_KERNEL_ARG_TYPE_NAME>(pos);
-                if (!std::isdigit(name.back()))
-                {
-                    std::cout << kernel.getArgInfo<CL_KERNEL_ARG_TYPE_NAME>(pos) << " is not a vector type." << std::endl;
-                    return;
-                }
-                kernel.setArg(pos, t);
-            }
-            else if constexpr (std::is_pointer_v<T>)
-            {
-                std::string name = kernel.getArgInfo<CL_KERNEL_ARG_TYPE_NAME>(pos);
-                if (name.back() != '*')
-                {
-                    std::cout << kernel.getArgInfo<CL_KERNEL_ARG_TYPE_NAME>(pos) << " is not a pointer type." << std::endl;
-                    return;
-                }
-                else if (size == 0)
-                {
-                    std::cout << "Pointer size < 0." << std::endl;
-                    return;
-                }
-                kernel.setArg(pos, size, t);
-            }
-            else if constexpr (std::is_same_v<T, cl::Buffer>)
-            {
-                kernel.setArg(pos, t);
-            }
-        }
-
-        void execute(cl::CommandQueue &cQueue);
-    };
-
-} // namespace opencl
-
+#ifndef OPENCL_KERNEL_HH
+#define OPENCL_KERNEL_HH
+
+#include <array>
+#include <cctype>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Concepts.hh"
+#include "Tuner.hh"
+
+#include <CL\cl2.hpp>
+
+namespace opencl
+{
+    class Program;
+
+    class Kernel
+    {
+    public:
+        struct Arg
+        {
+            std::string name;
+            std::string type;
+            cl_kernel_arg_address_qualifier address = CL_KERNEL_ARG_ADDRESS_PRIVATE;
+            cl_kernel_arg_access_qualifier access = CL_KERNEL_ARG_ACCESS_NONE;
+        };
+
+    private:
+        cl::Kernel generic;
+        std::string function;
+        cl::Kernel kernel; // Active kernel, generic or the variant for the current shape
+        Program *program;
+        std::array<cl_uint, 3> shape = {0, 0, 0};
+        std::vector<Arg> table; // Read once, empty when the driver has no arg info (arguments go unchecked)
+        std::size_t maxGroup = 0; // Of the active kernel, read on first tile()
+        std::map<unsigned int, cl::Buffer> buffers; // Last buffer bound per argument, held so the Tuner can time on copies
+        Tuner::Cache tuning;
+
+        friend class Tuner;
+
+    public:
+        Kernel(cl::Kernel kernel, std::vector<Arg> info = {}, Program *owner = nullptr);
+        ~Kernel();
+
+        operator cl::Kernel();
+
+        cl::NDRange global;
+        cl::NDRange local; // Fixed for kernels whose local memory depends on it, otherwise left to the Tuner
+
+        std::shared_ptr<Kernel> wide; // <name>Wide on CPU devices (see Device::initialise), null otherwise
+        cl_uint voxels = 0;           // Per work-item, of a wide kernel
+
+        const std::string &name() const;
+        const std::vector<Arg> &args() const;
+        std::string getArg(unsigned int pos);
+        bool isInput(unsigned int pos);
+        bool isOutput(unsigned int pos);
+
+        cl_uint numArgs();
+
+        // Switches to a build with these dimensions as compile-time constants, call before setting arguments.
+        void specialise(cl_uint depth, cl_uint length, cl_uint width);
+
+        // Pointwise kernels: the wide variant when there is one, otherwise this kernel specialised to the shape.
+        // Sets the dimensions (arguments 0 to 2), a wide kernel's count and span, and the global size. The
+        // caller sets the rest on the returned kernel.
+        Kernel &pointwise(cl_uint depth, cl_uint length, cl_uint width, cl_uint batch);
+
+        // Sets up a tiled stencil of radius r: fixes the local size (shrunk to fit the device), pads global to
+        // whole groups per frame and returns the bytes needed for the local tile argument.
+        std::size_t tile(cl::CommandQueue &cQueue, cl_uint depth, cl_uint length, cl_uint width, cl_uint batch, cl_uint r);
+
+        // Throws cl::Error (CL_INVALID_ARG_VALUE, CL_INVALID_ARG_SIZE) when t does not suit the kernel's argument.
+        template <concepts::OpenCLType T>
+        void setArg(unsigned int pos, T t, std::size_t size = 0)
+        {
+            const std::string *type = pos < table.size() ? &table[pos].type : nullptr;
+
+            // Element type known at compile time, e.g. cl_uchar4 must land on a uchar argument. Always on, it is a
+            // prefix compare against the table read once per kernel, cheap beside the driver call.
+            if constexpr (concepts::OpenCLScalarType<T> || concepts::OpenCLVectorType<T>)
+            {
+                if (type && !type->starts_with(concepts::openCLBaseName<T>()))
+                {
+                    std::cerr << *type << " is not a " << concepts::openCLBaseName<T>() << " type." << std::endl;
+                    throw cl::Error(CL_INVALID_ARG_VALUE, "Kernel::setArg");
+                }
+            }
+
+            if constexpr (concepts::OpenCLScalarType<T>)
+            {
+                if (type && !std::isalpha(type->back()))
+                {
+                    std::cerr << *type << " is not a scalar type." << std::endl;
+                    throw cl::Error(CL_INVALID_ARG_VALUE, "Kernel::setArg");
+                }
+                kernel.setArg(pos, t);
+            }
+            else if constexpr (concepts::OpenCLVectorType<T>)
+            {
+                if (type && !std::isdigit(type->back()))
+                {
+                    std::cerr << *type << " is not a vector type." << std::endl;
+                    throw cl::Error(CL_INVALID_ARG_VALUE, "Kernel::setArg");
+                }
+                kernel.setArg(pos, t);
+            }
+            else if constexpr (std::is_pointer_v<T>)
+            {
+                if (type && type->back() != '*')
+                {
+                    std::cerr << *type << " is not a pointer type." << std::endl;
+                    throw cl::Error(CL_INVALID_ARG_VALUE, "Kernel::setArg");
+                }
+                else if (size == 0)
+                {
+                    std::cerr << "Pointer size 0." << std::endl;
+                    throw cl::Error(CL_INVALID_ARG_SIZE, "Kernel::setArg");
+                }
+                kernel.setArg(pos, size, t);
+            }
+            else if constexpr (std::is_same_v<T, cl::Buffer>)
+            {
+                kernel.setArg(pos, t);
+                buffers[pos] = t;
+            }
+            else if constexpr (std::is_same_v<T, cl::Image3D>)
+            {
+                if (type && !type->starts_with("image3d_t"))
+                {
+                    std::cerr << *type << " is not an image3d_t type." << std::endl;
+                    throw cl::Error(CL_INVALID_ARG_VALUE, "Kernel::setArg");
+                }
+                kernel.setArg(pos, t);
+            }
+        }
+
+        void execute(cl::CommandQueue &cQueue);
+    };
+
+} // namespace opencl
+
 #endif
\ No newline at end of file
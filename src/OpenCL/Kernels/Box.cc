@@ -0,0 +1,143 @@
+#include "Box.hh"
+
+#include <cmath>
+
+#include "../Arena.hh"
+
+namespace opencl
+{
+
+    Box::Box(const Device &d, Statistic s) : Filter(d.cQueue), integral(d.programs.at("utility")->at("integralLine")), statistics(d.programs.at("utility")->at("boxStatistics")), statistic(s), context(d.context)
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::halo = [this]()
+        { return static_cast<cl_uint>(std::lround(sliders[2]->value * 16.0f)); };
+        // Output and two pairs of tables
+        Filter::footprint = []()
+        { return sizeof(cl_uint) + 2 * (sizeof(cl_uint) + sizeof(cl_ulong)); };
+        Filter::replicate = [this](const Device &other) -> std::shared_ptr<Filter>
+        {
+            auto f = std::make_shared<Box>(other, statistic);
+            f->sliders = sliders;
+            f->biasSlider = biasSlider;
+            return f;
+        };
+
+        for (auto &slider : sliders)
+        {
+            slider = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+            slider->value = 0.125f;
+        }
+        biasSlider = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+        biasSlider->value = 0.5f;
+    }
+
+    // Sliders span radius 0 to 16 voxels per axis, past that a box's squares no longer fit the variance maths.
+    std::array<cl_uint, 3> Box::radii()
+    {
+        std::array<cl_uint, 3> r;
+        for (std::size_t i = 0; i < r.size(); ++i)
+        {
+            r[i] = static_cast<cl_uint>(std::lround(sliders[i]->value * 16.0f));
+        }
+        if (inwidth == 1)
+            r[2] = 0;
+        return r;
+    }
+
+    void Box::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return;
+
+        volume->min = v->min;
+        volume->max = v->max;
+        inlength = v->length;
+        inwidth = v->width;
+        indepth = v->depth;
+        inBuffer = v->buffer;
+        volume->ratio = v->ratio;
+        volume->delta = v->delta;
+        volume->pointRange = v->pointRange;
+        volume->lineRange = v->lineRange;
+        volume->frames = v->frames;
+        volume->fRate = v->fRate;
+        volume->rFrame = v->rFrame;
+        volume->cFrame = v->cFrame;
+        volume->batch = v->batch;
+
+        volume->length = inlength;
+        volume->width = inwidth;
+        volume->depth = indepth;
+        volume->buffer = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+        for (std::size_t i = 0; i < sum.size(); ++i)
+        {
+            sum[i] = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+            squares[i] = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_ulong));
+        }
+    }
+
+    void Box::execute()
+    {
+        integral->specialise(indepth, inlength, inwidth);
+        integral->setArg(0, indepth);
+        integral->setArg(1, inlength);
+        integral->setArg(2, inwidth);
+        integral->setArg(3, inBuffer);
+
+        // A scan per line and axis, a 2D volume skips the width pass.
+        const cl::NDRange lines[3] = {
+            cl::NDRange(inlength, inwidth * volume->batch),
+            cl::NDRange(indepth, inwidth * volume->batch),
+            cl::NDRange(indepth, inlength * volume->batch)};
+        cl_uint axes = inwidth == 1 ? 2u : 3u;
+        for (cl_uint axis = 0; axis < axes; ++axis)
+        {
+            // Axis 0 reads the input, the table arguments it is given go unread.
+            cl_uint dst = axis % 2;
+            integral->setArg(4, sum[1 - dst]);
+            integral->setArg(5, squares[1 - dst]);
+            integral->setArg(6, sum[dst]);
+            integral->setArg(7, squares[dst]);
+            integral->setArg(8, axis);
+            integral->global = lines[axis];
+            integral->execute(queue);
+        }
+        cl_uint last = (axes - 1) % 2;
+
+        const std::array<cl_uint, 3> r = radii();
+        Kernel &k = statistics->pointwise(indepth, inlength, inwidth, volume->batch);
+        k.setArg(3, inBuffer);
+        k.setArg(4, sum[last]);
+        k.setArg(5, squares[last]);
+        k.setArg(6, volume->buffer);
+        k.setArg(7, cl_uint4{{r[0], r[1], r[2], 0}});
+        k.setArg(8, static_cast<cl_uint>(statistic));
+        k.setArg(9, (biasSlider->value - 0.5f) * 128.0f);
+
+        k.execute(queue);
+    }
+
+    std::shared_ptr<gui::Tree> Box::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+
+        // Radius along depth, length and width
+        for (auto &slider : sliders)
+        {
+            slider->resize(0.0f, 0.0f, options->w, 0.0f);
+            options->addLeaf(slider);
+        }
+
+        // Bias over the local mean, -64 to 64
+        if (statistic == Statistic::Threshold)
+        {
+            biasSlider->resize(0.0f, 0.0f, options->w, 0.0f);
+            options->addLeaf(biasSlider);
+        }
+        return options;
+    }
+} // namespace opencl
\ No newline at end of file
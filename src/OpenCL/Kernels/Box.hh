@@ -0,0 +1,63 @@
+#ifndef OPENCL_KERNELS_BOX_HH
+#define OPENCL_KERNELS_BOX_HH
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <CL/cl2.hpp>
+
+#include "../Device.hh"
+#include "../Filter.hh"
+#include "../Kernel.hh"
+#include "../Concepts.hh"
+#include "../../Data/Volume.hh"
+#include "../../GUI/Tree.hh"
+#include "../../GUI/Slider.hh"
+
+namespace opencl
+{
+    // Box mean, variance and adaptive threshold through summed-area tables, the cost per voxel does not grow
+    // with the radius.
+    class Box : public Filter
+    {
+    public:
+        enum class Statistic
+        {
+            Mean,
+            Variance,
+            Threshold
+        };
+
+    private:
+        std::shared_ptr<opencl::Kernel> integral;
+        std::shared_ptr<opencl::Kernel> statistics;
+        cl_uint inlength;
+        cl_uint inwidth;
+        cl_uint indepth;
+        cl::Buffer inBuffer;
+        std::array<cl::Buffer, 2> sum; // Each axis pass reads one table pair and writes the other
+        std::array<cl::Buffer, 2> squares;
+        Statistic statistic;
+        std::array<std::shared_ptr<gui::Slider>, 3> sliders;
+        std::shared_ptr<gui::Slider> biasSlider; // Threshold only
+
+        std::array<cl_uint, 3> radii();
+
+    public:
+        cl::Context context;
+
+        const std::string in = "3D";
+        const std::string out = "3D";
+
+        Box(const Device &d, Statistic s);
+        ~Box() = default;
+
+        void input(const std::weak_ptr<data::Volume> &wv);
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+} // namespace opencl
+
+#endif
\ No newline at end of file
@@ -1,68 +1,79 @@
-#include "Colourise.hh"
-
-#include "../../GUI/Slider.hh"
-
-namespace opencl
-{
-
-    Colourise::Colourise(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr) : kernel(ptr), context(c), queue(q)
-    {
-        Filter::input = std::bind(input, this, std::placeholders::_1);
-        Filter::execute = std::bind(execute, this);
-        Filter::getOptions = std::bind(getOptions, this);
-    }
-
-    void Colourise::input(const std::weak_ptr<data::Volume> &wv)
-    {
-        auto v = wv.lock();
-        if (!v)
-            return;
-
-        volume->min = v->min;
-        volume->max = v->max;
-        inlength = v->length;
-        inwidth = v->width;
-        indepth = v->depth;
-        inBuffer = v->buffer;
-        volume->ratio = v->ratio;
-        volume->delta = v->delta;
-        volume->frames = v->frames;
-        volume->fRate = v->fRate;
-        volume->rFrame = v->rFrame;
-        volume->cFrame = v->cFrame;
-
-        volume->length = inlength;
-        volume->width = inwidth;
-        volume->depth = indepth;
-        volume->buffer = cl::Buffer(context, CL_MEM_READ_WRITE, volume->length * volume->depth * volume->width * sizeof(cl_uint));
-    }
-
-    void Colourise::execute()
-    {
-        kernel->setArg(0, indepth);
-        kernel->setArg(1, inlength);
-        kernel->setArg(2, inwidth);
-        kernel->setArg(3, inBuffer);
-        kernel->setArg(4, volume->buffer);
-
-        for (unsigned int i = 0; i < sliders.size(); ++i)
-        {
-            kernel->setArg(i+5, sliders[i]->value);
-        }
-
-        kernel->global = cl::NDRange(volume->depth, volume->length, volume->width);
-        kernel->execute(queue);
-    }
-
-    std::shared_ptr<gui::Tree> Colourise::getOptions()
-    {
-        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
-        for (unsigned int i = 0; i < sliders.size(); ++i)
-        {
-            sliders[i] = gui::Slider::build(0.0f, 0.0f, options->w, 10.0f);
-            options->addLeaf(sliders[i]);
-        }
-        return options;
-    }
-
-} // namespace opencl
+#include "Colourise.hh"
+
+#include "../Arena.hh"
+#include "../Device.hh"
+
+#include "../../GUI/Slider.hh"
+
+namespace opencl
+{
+
+    Colourise::Colourise(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr) : Filter(q), kernel(ptr), context(c)
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::halo = []()
+        { return 0u; };
+        Filter::replicate = [this](const Device &d) -> std::shared_ptr<Filter>
+        {
+            auto f = std::make_shared<Colourise>(d.context, d.cQueue, d.programs.at("utility")->at("colourise"));
+            f->sliders = sliders;
+            return f;
+        };
+    }
+
+    void Colourise::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return;
+
+        volume->min = v->min;
+        volume->max = v->max;
+        inlength = v->length;
+        inwidth = v->width;
+        indepth = v->depth;
+        inBuffer = v->buffer;
+        volume->ratio = v->ratio;
+        volume->delta = v->delta;
+        volume->pointRange = v->pointRange;
+        volume->lineRange = v->lineRange;
+        volume->frames = v->frames;
+        volume->fRate = v->fRate;
+        volume->rFrame = v->rFrame;
+        volume->cFrame = v->cFrame;
+        volume->batch = v->batch;
+
+        volume->length = inlength;
+        volume->width = inwidth;
+        volume->depth = indepth;
+        volume->buffer = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+    }
+
+    void Colourise::execute()
+    {
+        Kernel &k = kernel->pointwise(indepth, inlength, inwidth, volume->batch);
+        k.setArg(3, inBuffer);
+        k.setArg(4, volume->buffer);
+
+        for (unsigned int i = 0; i < sliders.size(); ++i)
+        {
+            k.setArg(i+5, sliders[i]->value);
+        }
+
+        k.execute(queue);
+    }
+
+    std::shared_ptr<gui::Tree> Colourise::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+        for (unsigned int i = 0; i < sliders.size(); ++i)
+        {
+            sliders[i] = gui::Slider::build(0.0f, 0.0f, options->w, 10.0f);
+            options->addLeaf(sliders[i]);
+        }
+        return options;
+    }
+
+} // namespace opencl
@@ -1,47 +1,46 @@
-#ifndef OPENCL_KERNELS_COLOURISE_HH
-#define OPENCL_KERNELS_COLOURISE_HH
-
-#include <array>
-#include <memory>
-#include <string>
-
-#include <CL/cl2.hpp>
-
-#include "../Filter.hh"
-#include "../Kernel.hh"
-#include "../Concepts.hh"
-#include "../../Data/Volume.hh"
-#include "../../GUI/Tree.hh"
-#include "../../GUI/Slider.hh"
-
-namespace opencl
-{
-    class Colourise : public Filter
-    {
-    private:
-        std::shared_ptr<opencl::Kernel> kernel;
-        cl_uint inlength;
-        cl_uint inwidth;
-        cl_uint indepth;
-        cl::Buffer inBuffer;
-
-        std::array<std::shared_ptr<gui::Slider>, 3> sliders;
-
-    public:
-        cl::Context context;
-        cl::CommandQueue queue;
-
-        const std::string in = "3D";
-        const std::string out = "3D";
-
-        Colourise(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr);
-        ~Colourise() = default;
-
-        void input(const std::weak_ptr<data::Volume> &wv);
-        void execute();
-        std::shared_ptr<gui::Tree> getOptions();
-    };
-
-} // namespace opencl
-
+#ifndef OPENCL_KERNELS_COLOURISE_HH
+#define OPENCL_KERNELS_COLOURISE_HH
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <CL/cl2.hpp>
+
+#include "../Filter.hh"
+#include "../Kernel.hh"
+#include "../Concepts.hh"
+#include "../../Data/Volume.hh"
+#include "../../GUI/Tree.hh"
+#include "../../GUI/Slider.hh"
+
+namespace opencl
+{
+    class Colourise : public Filter
+    {
+    private:
+        std::shared_ptr<opencl::Kernel> kernel;
+        cl_uint inlength;
+        cl_uint inwidth;
+        cl_uint indepth;
+        cl::Buffer inBuffer;
+
+        std::array<std::shared_ptr<gui::Slider>, 3> sliders;
+
+    public:
+        cl::Context context;
+
+        const std::string in = "3D";
+        const std::string out = "3D";
+
+        Colourise(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr);
+        ~Colourise() = default;
+
+        void input(const std::weak_ptr<data::Volume> &wv);
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+} // namespace opencl
+
 #endif
\ No newline at end of file
@@ -1,55 +1,62 @@
-#include "Fade.hh"
-
-namespace opencl
-{
-    Fade::Fade(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr) : kernel(ptr), context(c), queue(q)
-    {
-        Filter::input = std::bind(input, this, std::placeholders::_1);
-        Filter::execute = std::bind(execute, this);
-        Filter::getOptions = std::bind(getOptions, this);
-    }
-
-    void Fade::input(const std::weak_ptr<data::Volume> &wv)
-    {
-        auto v = wv.lock();
-        if (!v)
-            return;
-
-        volume->min = v->min;
-        volume->max = v->max;
-        inlength = v->length;
-        inwidth = v->width;
-        indepth = v->depth;
-        inBuffer = v->buffer;
-        volume->ratio = v->ratio;
-        volume->delta = v->delta;
-        volume->frames = v->frames;
-        volume->fRate = v->fRate;
-        volume->rFrame = v->rFrame;
-        volume->cFrame = v->cFrame;
-
-        volume->length = inlength;
-        volume->width = inwidth;
-        volume->depth = indepth;
-        volume->buffer = cl::Buffer(context, CL_MEM_READ_WRITE, volume->length * volume->depth * volume->width * sizeof(cl_uint));
-    }
-
-    void Fade::execute()
-    {
-        kernel->setArg(0, indepth);
-        kernel->setArg(1, inlength);
-        kernel->setArg(2, inwidth);
-        kernel->setArg(3, inBuffer);
-        kernel->setArg(4, volume->buffer);
-
-        kernel->global = cl::NDRange(volume->depth, volume->length, volume->width);
-        kernel->execute(queue);
-    }
-
-    std::shared_ptr<gui::Tree> Fade::getOptions()
-    {
-        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
-        // options->addLeaf(Slider::build(0.0f, 0.0f, options->w, 10.0f));
-        return options;
-    }
-} // namespace opencl
+#include "Fade.hh"
+
+#include "../Arena.hh"
+#include "../Device.hh"
+
+namespace opencl
+{
+    Fade::Fade(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr) : Filter(q), kernel(ptr), context(c)
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::halo = []()
+        { return 0u; };
+        Filter::replicate = [](const Device &d) -> std::shared_ptr<Filter>
+        { return std::make_shared<Fade>(d.context, d.cQueue, d.programs.at("utility")->at("fade")); };
+    }
+
+    void Fade::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return;
+
+        volume->min = v->min;
+        volume->max = v->max;
+        inlength = v->length;
+        inwidth = v->width;
+        indepth = v->depth;
+        inBuffer = v->buffer;
+        volume->ratio = v->ratio;
+        volume->delta = v->delta;
+        volume->pointRange = v->pointRange;
+        volume->lineRange = v->lineRange;
+        volume->frames = v->frames;
+        volume->fRate = v->fRate;
+        volume->rFrame = v->rFrame;
+        volume->cFrame = v->cFrame;
+        volume->batch = v->batch;
+
+        volume->length = inlength;
+        volume->width = inwidth;
+        volume->depth = indepth;
+        volume->buffer = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+    }
+
+    void Fade::execute()
+    {
+        Kernel &k = kernel->pointwise(indepth, inlength, inwidth, volume->batch);
+        k.setArg(3, inBuffer);
+        k.setArg(4, volume->buffer);
+
+        k.execute(queue);
+    }
+
+    std::shared_ptr<gui::Tree> Fade::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+        // options->addLeaf(Slider::build(0.0f, 0.0f, options->w, 10.0f));
+        return options;
+    }
+} // namespace opencl
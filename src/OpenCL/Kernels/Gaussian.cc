@@ -1,68 +1,134 @@
-#include "Gaussian.hh"
-
-namespace opencl
-{
-
-    Gaussian::Gaussian(const Device &d) : kernel2D(d.programs.at("utility")->at("gaussian2D")), kernel3D(d.programs.at("utility")->at("gaussian3D")), context(d.context), queue(d.cQueue)
-    {
-        Filter::input = std::bind(input, this, std::placeholders::_1);
-        Filter::execute = std::bind(execute, this);
-        Filter::getOptions = std::bind(getOptions, this);
-    }
-
-    void Gaussian::input(const std::weak_ptr<data::Volume> &wv)
-    {
-        auto v = wv.lock();
-        if (!v)
-            return;
-
-        volume->min = v->min;
-        volume->max = v->max;
-        inlength = v->length;
-        inwidth = v->width;
-        indepth = v->depth;
-        inBuffer = v->buffer;
-        volume->ratio = v->ratio;
-        volume->delta = v->delta;
-        volume->frames = v->frames;
-        volume->fRate = v->fRate;
-        volume->rFrame = v->rFrame;
-        volume->cFrame = v->cFrame;
-
-        volume->length = inlength;
-        volume->width = inwidth;
-        volume->depth = indepth;
-        volume->buffer = cl::Buffer(context, CL_MEM_READ_WRITE, volume->length * volume->depth * volume->width * sizeof(cl_uint));
-    }
-
-    void Gaussian::execute()
-    {
-        if (inwidth == 1)
-        {
-            kernel2D->setArg(0, indepth);
-            kernel2D->setArg(1, inlength);
-            kernel2D->setArg(2, inBuffer);
-            kernel2D->setArg(3, volume->buffer);
-
-            kernel2D->global = cl::NDRange(volume->depth, volume->length);
-            kernel2D->execute(queue);
-        }
-        else
-        {
-            kernel3D->setArg(0, indepth);
-            kernel3D->setArg(1, inlength);
-            kernel3D->setArg(2, inwidth);
-            kernel3D->setArg(3, inBuffer);
-            kernel3D->setArg(4, volume->buffer);
-
-            kernel3D->global = cl::NDRange(volume->depth, volume->length, volume->width);
-            kernel3D->execute(queue);
-        }
-    }
-
-    std::shared_ptr<gui::Tree> Gaussian::getOptions()
-    {
-        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
-        return options;
-    }
-} // namespace opencl
+#include "Gaussian.hh"
+
+#include <cmath>
+
+#include "../Arena.hh"
+
+namespace opencl
+{
+
+    Gaussian::Gaussian(const Device &d) : Filter(d.cQueue), toFloat(d.programs.at("utility")->at("alphaToFloat")), iir(d.programs.at("utility")->at("gaussianIIR")), fromFloat(d.programs.at("utility")->at("floatToAlpha")), context(d.context)
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        // The recursive filter reaches the whole line, past 4 sigma the weights are below 1e-3.
+        Filter::halo = [this]()
+        { return static_cast<cl_uint>(std::ceil(4.0f * sigma(sigmaSlider->value))); };
+        // Output and the two float alpha buffers
+        Filter::footprint = []()
+        { return sizeof(cl_uint) + 2 * sizeof(cl_float); };
+        Filter::replicate = [this](const Device &other) -> std::shared_ptr<Filter>
+        {
+            auto f = std::make_shared<Gaussian>(other);
+            f->sigmaSlider = sigmaSlider;
+            return f;
+        };
+
+        sigmaSlider = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+        sigmaSlider->value = 0.15f;
+    }
+
+    // Slider spans sigma 0.5 to 10 voxels, the recursive coefficients are only accurate from 0.5.
+    cl_float Gaussian::sigma(cl_float slider)
+    {
+        return 0.5f + slider * 9.5f;
+    }
+
+    // Young and van Vliet coefficients
+    cl_float4 Gaussian::coefficients(cl_float sg)
+    {
+        cl_float q = sg >= 2.5f ? 0.98711f * sg - 0.96330f : 3.97156f - 4.14554f * std::sqrt(1.0f - 0.26891f * sg);
+        cl_float b0 = 1.57825f + 2.44413f * q + 1.4281f * q * q + 0.422205f * q * q * q;
+        cl_float b1 = 2.44413f * q + 2.85619f * q * q + 1.26661f * q * q * q;
+        cl_float b2 = -(1.4281f * q * q + 1.26661f * q * q * q);
+        cl_float b3 = 0.422205f * q * q * q;
+        return {{1.0f - (b1 + b2 + b3) / b0, b1 / b0, b2 / b0, b3 / b0}};
+    }
+
+    void Gaussian::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return;
+
+        volume->min = v->min;
+        volume->max = v->max;
+        inlength = v->length;
+        inwidth = v->width;
+        indepth = v->depth;
+        inBuffer = v->buffer;
+        volume->ratio = v->ratio;
+        volume->delta = v->delta;
+        volume->pointRange = v->pointRange;
+        volume->lineRange = v->lineRange;
+        volume->frames = v->frames;
+        volume->fRate = v->fRate;
+        volume->rFrame = v->rFrame;
+        volume->cFrame = v->cFrame;
+        volume->batch = v->batch;
+
+        volume->length = inlength;
+        volume->width = inwidth;
+        volume->depth = indepth;
+        volume->buffer = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+        for (auto &a : alpha)
+        {
+            a = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_float));
+        }
+    }
+
+    void Gaussian::execute()
+    {
+        cl_float4 coeffs = coefficients(sigma(sigmaSlider->value));
+
+        std::size_t voxels = std::size_t(indepth) * inlength * inwidth * volume->batch;
+
+        toFloat->setArg(0, indepth);
+        toFloat->setArg(1, inlength);
+        toFloat->setArg(2, inwidth);
+        toFloat->setArg(3, inBuffer);
+        toFloat->setArg(4, alpha[0]);
+        toFloat->global = cl::NDRange(voxels);
+        toFloat->execute(queue);
+
+        iir->specialise(indepth, inlength, inwidth);
+        iir->setArg(0, indepth);
+        iir->setArg(1, inlength);
+        iir->setArg(2, inwidth);
+        iir->setArg(6, coeffs);
+
+        // One work-item per line, a 2D volume skips the width pass.
+        const cl::NDRange lines[3] = {
+            cl::NDRange(inlength, inwidth * volume->batch),
+            cl::NDRange(indepth, inwidth * volume->batch),
+            cl::NDRange(indepth, inlength * volume->batch)};
+        cl_uint src = 0;
+        for (cl_uint axis = 0; axis < (inwidth == 1 ? 2u : 3u); ++axis)
+        {
+            iir->setArg(3, alpha[src]);
+            iir->setArg(4, alpha[1 - src]);
+            iir->setArg(5, axis);
+            iir->global = lines[axis];
+            iir->execute(queue);
+            src = 1 - src;
+        }
+
+        fromFloat->setArg(0, indepth);
+        fromFloat->setArg(1, inlength);
+        fromFloat->setArg(2, inwidth);
+        fromFloat->setArg(3, inBuffer);
+        fromFloat->setArg(4, alpha[src]);
+        fromFloat->setArg(5, volume->buffer);
+        fromFloat->global = cl::NDRange(voxels);
+        fromFloat->execute(queue);
+    }
+
+    std::shared_ptr<gui::Tree> Gaussian::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+        sigmaSlider->resize(0.0f, 0.0f, options->w, 0.0f);
+        options->addLeaf(sigmaSlider);
+        return options;
+    }
+} // namespace opencl
@@ -1,45 +1,53 @@
-#ifndef OPENCL_KERNELS_GAUSSIAN_HH
-#define OPENCL_KERNELS_GAUSSIAN_HH
-
-#include <memory>
-#include <string>
-
-#include <CL/cl2.hpp>
-
-#include "../Device.hh"
-#include "../Filter.hh"
-#include "../Kernel.hh"
-#include "../Concepts.hh"
-#include "../../Data/Volume.hh"
-#include "../../GUI/Tree.hh"
-
-namespace opencl
-{
-    class Gaussian : public Filter
-    {
-    private:
-        std::shared_ptr<opencl::Kernel> kernel2D;
-        std::shared_ptr<opencl::Kernel> kernel3D;
-        cl_uint inlength;
-        cl_uint inwidth;
-        cl_uint indepth;
-        cl::Buffer inBuffer;
-
-    public:
-        cl::Context context;
-        cl::CommandQueue queue;
-
-        const std::string in = "3D";
-        const std::string out = "3D";
-
-        Gaussian(const Device &d);
-        ~Gaussian() = default;
-
-        void input(const std::weak_ptr<data::Volume> &wv);
-        void execute();
-        std::shared_ptr<gui::Tree> getOptions();
-    };
-
-} // namespace opencl
-
+#ifndef OPENCL_KERNELS_GAUSSIAN_HH
+#define OPENCL_KERNELS_GAUSSIAN_HH
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <CL/cl2.hpp>
+
+#include "../Device.hh"
+#include "../Filter.hh"
+#include "../Kernel.hh"
+#include "../Concepts.hh"
+#include "../../Data/Volume.hh"
+#include "../../GUI/Tree.hh"
+#include "../../GUI/Slider.hh"
+
+namespace opencl
+{
+    class Gaussian : public Filter
+    {
+    private:
+        std::shared_ptr<opencl::Kernel> toFloat;
+        std::shared_ptr<opencl::Kernel> iir;
+        std::shared_ptr<opencl::Kernel> fromFloat;
+        cl_uint inlength;
+        cl_uint inwidth;
+        cl_uint indepth;
+        cl::Buffer inBuffer;
+        std::array<cl::Buffer, 2> alpha; // Each axis pass reads one and writes the other
+        std::shared_ptr<gui::Slider> sigmaSlider;
+
+    public:
+        // Sigma for a slider value and its Young and van Vliet coefficients (B, b1, b2, b3 over b0).
+        static cl_float sigma(cl_float slider);
+        static cl_float4 coefficients(cl_float sigma);
+
+        cl::Context context;
+
+        const std::string in = "3D";
+        const std::string out = "3D";
+
+        Gaussian(const Device &d);
+        ~Gaussian() = default;
+
+        void input(const std::weak_ptr<data::Volume> &wv);
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+} // namespace opencl
+
 #endif
\ No newline at end of file
@@ -1,70 +1,102 @@
-#include "MedianNoise.hh"
-
-namespace opencl
-{
-
-    Median::Median(const Device &d) : kernel2D(d.programs.at("utility")->at("medianNoise2D")), kernel3D(d.programs.at("utility")->at("medianNoise3D")), context(d.context), queue(d.cQueue)
-    {
-        Filter::input = std::bind(input, this, std::placeholders::_1);
-        Filter::execute = std::bind(execute, this);
-        Filter::getOptions = std::bind(getOptions, this);
-    }
-
-    void Median::input(const std::weak_ptr<data::Volume> &wv)
-    {
-        auto v = wv.lock();
-        if (!v)
-            return;
-
-        volume->min = v->min;
-        volume->max = v->max;
-        inlength = v->length;
-        inwidth = v->width;
-        indepth = v->depth;
-        inBuffer = v->buffer;
-        volume->ratio = v->ratio;
-        volume->delta = v->delta;
-        volume->frames = v->frames;
-        volume->fRate = v->fRate;
-        volume->rFrame = v->rFrame;
-        volume->cFrame = v->cFrame;
-
-        volume->length = inlength;
-        volume->width = inwidth;
-        volume->depth = indepth;
-        volume->buffer = cl::Buffer(context, CL_MEM_READ_WRITE, volume->length * volume->depth * volume->width * sizeof(cl_uint));
-    }
-
-    void Median::execute()
-    {
-        if (inwidth == 1)
-        {
-            kernel2D->setArg(0, indepth);
-            kernel2D->setArg(1, inlength);
-            kernel2D->setArg(2, inBuffer);
-            kernel2D->setArg(3, volume->buffer);
-
-            kernel2D->global = cl::NDRange(volume->depth, volume->length);
-            kernel2D->execute(queue);
-
-        }
-        else
-        {
-            kernel3D->setArg(0, indepth);
-            kernel3D->setArg(1, inlength);
-            kernel3D->setArg(2, inwidth);
-            kernel3D->setArg(3, inBuffer);
-            kernel3D->setArg(4, volume->buffer);
-
-            kernel3D->global = cl::NDRange(volume->depth, volume->length, volume->width);
-            kernel3D->execute(queue);
-        }
-
-    }
-
-    std::shared_ptr<gui::Tree> Median::getOptions()
-    {
-        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
-        return options;
-    }
-} // namespace opencl
+#include "MedianNoise.hh"
+
+#include <cmath>
+
+#include "../Arena.hh"
+
+namespace opencl
+{
+
+    Median::Median(const Device &d) : Filter(d.cQueue), network(d.programs.at("utility")->at("medianNetwork")), histogram(d.programs.at("utility")->at("medianHistogram")), context(d.context)
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::halo = [this]()
+        { return radius(); };
+        Filter::replicate = [this](const Device &other) -> std::shared_ptr<Filter>
+        {
+            auto f = std::make_shared<Median>(other);
+            f->radiusSlider = radiusSlider;
+            return f;
+        };
+
+        radiusSlider = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+    }
+
+    // Slider spans radius 1 to 5
+    cl_uint Median::radius()
+    {
+        return 1 + static_cast<cl_uint>(std::lround(radiusSlider->value * 4.0f));
+    }
+
+    void Median::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return;
+
+        volume->min = v->min;
+        volume->max = v->max;
+        inlength = v->length;
+        inwidth = v->width;
+        indepth = v->depth;
+        inBuffer = v->buffer;
+        volume->ratio = v->ratio;
+        volume->delta = v->delta;
+        volume->pointRange = v->pointRange;
+        volume->lineRange = v->lineRange;
+        volume->frames = v->frames;
+        volume->fRate = v->fRate;
+        volume->rFrame = v->rFrame;
+        volume->cFrame = v->cFrame;
+        volume->batch = v->batch;
+
+        volume->length = inlength;
+        volume->width = inwidth;
+        volume->depth = indepth;
+        volume->buffer = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+    }
+
+    void Median::execute()
+    {
+        cl_uint r = radius();
+        cl_uint rz = inwidth == 1 ? 0 : r;
+
+        // The selection window holds (n + 3) / 2 taps, medianNetwork has room for 64 (n <= 125).
+        if ((2 * r + 1) * (2 * r + 1) * (2 * rz + 1) <= 125)
+        {
+            network->specialise(indepth, inlength, inwidth);
+            network->setArg(0, indepth);
+            network->setArg(1, inlength);
+            network->setArg(2, inwidth);
+            network->setArg(3, inBuffer);
+            network->setArg(4, volume->buffer);
+            network->setArg(5, static_cast<cl_uchar *>(nullptr), network->tile(queue, indepth, inlength, inwidth, volume->batch, r));
+            network->setArg(6, r);
+
+            network->execute(queue);
+        }
+        else
+        {
+            histogram->specialise(indepth, inlength, inwidth);
+            histogram->setArg(0, indepth);
+            histogram->setArg(1, inlength);
+            histogram->setArg(2, inwidth);
+            histogram->setArg(3, inBuffer);
+            histogram->setArg(4, volume->buffer);
+            histogram->setArg(5, r);
+
+            histogram->global = cl::NDRange(inlength, inwidth * volume->batch);
+            histogram->execute(queue);
+        }
+    }
+
+    std::shared_ptr<gui::Tree> Median::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+        radiusSlider->resize(0.0f, 0.0f, options->w, 0.0f);
+        options->addLeaf(radiusSlider);
+        return options;
+    }
+} // namespace opencl
@@ -1,45 +1,48 @@
-#ifndef OPENCL_KERNELS_MEDIANNOISE_HH
-#define OPENCL_KERNELS_MEDIANNOISE_HH
-
-#include <memory>
-#include <string>
-
-#include <CL/cl2.hpp>
-
-#include "../Device.hh"
-#include "../Filter.hh"
-#include "../Kernel.hh"
-#include "../Concepts.hh"
-#include "../../Data/Volume.hh"
-#include "../../GUI/Tree.hh"
-
-namespace opencl
-{
-    class Median : public Filter
-    {
-    private:
-        std::shared_ptr<opencl::Kernel> kernel2D;
-        std::shared_ptr<opencl::Kernel> kernel3D;
-        cl_uint inlength;
-        cl_uint inwidth;
-        cl_uint indepth;
-        cl::Buffer inBuffer;
-
-    public:
-        cl::Context context;
-        cl::CommandQueue queue;
-
-        const std::string in = "3D";
-        const std::string out = "3D";
-
-        Median(const Device &d);
-        ~Median() = default;
-
-        void input(const std::weak_ptr<data::Volume> &wv);
-        void execute();
-        std::shared_ptr<gui::Tree> getOptions();
-    };
-
-} // namespace opencl
-
+#ifndef OPENCL_KERNELS_MEDIANNOISE_HH
+#define OPENCL_KERNELS_MEDIANNOISE_HH
+
+#include <memory>
+#include <string>
+
+#include <CL/cl2.hpp>
+
+#include "../Device.hh"
+#include "../Filter.hh"
+#include "../Kernel.hh"
+#include "../Concepts.hh"
+#include "../../Data/Volume.hh"
+#include "../../GUI/Tree.hh"
+#include "../../GUI/Slider.hh"
+
+namespace opencl
+{
+    class Median : public Filter
+    {
+    private:
+        std::shared_ptr<opencl::Kernel> network;
+        std::shared_ptr<opencl::Kernel> histogram;
+        cl_uint inlength;
+        cl_uint inwidth;
+        cl_uint indepth;
+        cl::Buffer inBuffer;
+        std::shared_ptr<gui::Slider> radiusSlider;
+
+        cl_uint radius();
+
+    public:
+        cl::Context context;
+
+        const std::string in = "3D";
+        const std::string out = "3D";
+
+        Median(const Device &d);
+        ~Median() = default;
+
+        void input(const std::weak_ptr<data::Volume> &wv);
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+} // namespace opencl
+
 #endif
\ No newline at end of file
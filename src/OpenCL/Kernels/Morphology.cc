@@ -0,0 +1,196 @@
+#include "Morphology.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../Arena.hh"
+#include "../../GUI/Button.hh"
+
+namespace opencl
+{
+
+    Morphology::Morphology(const Device &d) : Filter(d.cQueue), extract(d.programs.at("utility")->at("extractAlpha")), line(d.programs.at("utility")->at("morphologyLine")), insert(d.programs.at("utility")->at("insertAlpha")), context(d.context)
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::halo = [this]()
+        {
+            cl_uint r = static_cast<cl_uint>(std::lround(sliders[2]->value * 8.0f));
+            return *operation == Operation::Open || *operation == Operation::Close ? 2 * r : r;
+        };
+        // Output, the two alpha buffers and the line scratch (n + 2r bytes a line, at most about 2 a voxel)
+        Filter::footprint = []()
+        { return sizeof(cl_uint) + 2 * sizeof(cl_uchar) + 2 * sizeof(cl_uchar); };
+        Filter::replicate = [this](const Device &other) -> std::shared_ptr<Filter>
+        {
+            auto f = std::make_shared<Morphology>(other);
+            f->operation = operation;
+            f->sliders = sliders;
+            return f;
+        };
+
+        operation = std::make_shared<Operation>(Operation::Erode);
+        for (auto &s : sliders)
+        {
+            s = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+            s->value = 0.125f;
+        }
+    }
+
+    void Morphology::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return;
+
+        volume->min = v->min;
+        volume->max = v->max;
+        inlength = v->length;
+        inwidth = v->width;
+        indepth = v->depth;
+        inBuffer = v->buffer;
+        volume->ratio = v->ratio;
+        volume->delta = v->delta;
+        volume->pointRange = v->pointRange;
+        volume->lineRange = v->lineRange;
+        volume->frames = v->frames;
+        volume->fRate = v->fRate;
+        volume->rFrame = v->rFrame;
+        volume->cFrame = v->cFrame;
+        volume->batch = v->batch;
+
+        volume->length = inlength;
+        volume->width = inwidth;
+        volume->depth = indepth;
+        volume->buffer = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+
+        for (auto &a : alpha)
+        {
+            a = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uchar));
+        }
+        scratchSize = 0;
+    }
+
+    // Sliders span radius 0 to 8 voxels per axis
+    std::array<cl_uint, 3> Morphology::radii()
+    {
+        std::array<cl_uint, 3> r;
+        for (std::size_t i = 0; i < r.size(); ++i)
+        {
+            r[i] = static_cast<cl_uint>(std::lround(sliders[i]->value * 8.0f));
+        }
+        if (inwidth == 1)
+            r[2] = 0;
+        return r;
+    }
+
+    // One erosion or dilation, a line pass per axis ping-ponging between the alpha buffers.
+    void Morphology::pass(cl_uint dilate, cl_uint &src)
+    {
+        const std::array<cl_uint, 3> r = radii();
+        const cl::NDRange lines[3] = {
+            cl::NDRange(inlength, inwidth * volume->batch),
+            cl::NDRange(indepth, inwidth * volume->batch),
+            cl::NDRange(indepth, inlength * volume->batch)};
+
+        for (cl_uint axis = 0; axis < 3; ++axis)
+        {
+            if (r[axis] == 0)
+                continue;
+
+            line->setArg(3, alpha[src]);
+            line->setArg(4, alpha[1 - src]);
+            line->setArg(6, axis);
+            line->setArg(7, r[axis]);
+            line->setArg(8, dilate);
+
+            line->global = lines[axis];
+            line->execute(queue);
+            src = 1 - src;
+        }
+    }
+
+    void Morphology::execute()
+    {
+        std::size_t voxels = std::size_t(indepth) * inlength * inwidth * volume->batch;
+        const std::array<cl_uint, 3> dims = {indepth, inlength, inwidth};
+        const std::array<cl_uint, 3> r = radii();
+
+        // Every line needs n + 2r bytes of scratch
+        std::size_t need = 0;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            need = std::max(need, voxels + voxels / dims[i] * 2 * r[i]);
+        }
+        if (need > scratchSize)
+        {
+            scratch = Arena::allocate(context, need);
+            scratchSize = need;
+        }
+
+        extract->setArg(0, indepth);
+        extract->setArg(1, inlength);
+        extract->setArg(2, inwidth);
+        extract->setArg(3, inBuffer);
+        extract->setArg(4, alpha[0]);
+        extract->global = cl::NDRange(voxels);
+        extract->execute(queue);
+
+        line->specialise(indepth, inlength, inwidth);
+        line->setArg(0, indepth);
+        line->setArg(1, inlength);
+        line->setArg(2, inwidth);
+        line->setArg(5, scratch);
+
+        cl_uint src = 0;
+        switch (*operation)
+        {
+        case Operation::Erode:
+            pass(0, src);
+            break;
+        case Operation::Dilate:
+            pass(1, src);
+            break;
+        case Operation::Open:
+            pass(0, src);
+            pass(1, src);
+            break;
+        case Operation::Close:
+            pass(1, src);
+            pass(0, src);
+            break;
+        }
+
+        insert->setArg(0, indepth);
+        insert->setArg(1, inlength);
+        insert->setArg(2, inwidth);
+        insert->setArg(3, inBuffer);
+        insert->setArg(4, alpha[src]);
+        insert->setArg(5, volume->buffer);
+        insert->global = cl::NDRange(voxels);
+        insert->execute(queue);
+    }
+
+    std::shared_ptr<gui::Tree> Morphology::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+
+        const std::pair<const char *, Operation> ops[] = {{"ERODE", Operation::Erode}, {"DILATE", Operation::Dilate}, {"OPEN", Operation::Open}, {"CLOSE", Operation::Close}};
+        for (const auto &[name, op] : ops)
+        {
+            auto button = gui::Button::build(name);
+            button->onPress([target = operation, choice = op]()
+                            { *target = choice; });
+            options->addLeaf(std::move(button));
+        }
+
+        // Radius along depth, length and width
+        for (auto &s : sliders)
+        {
+            s->resize(0.0f, 0.0f, options->w, 0.0f);
+            options->addLeaf(s);
+        }
+        return options;
+    }
+} // namespace opencl
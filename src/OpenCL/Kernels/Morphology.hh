@@ -0,0 +1,64 @@
+#ifndef OPENCL_KERNELS_MORPHOLOGY_HH
+#define OPENCL_KERNELS_MORPHOLOGY_HH
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <CL/cl2.hpp>
+
+#include "../Device.hh"
+#include "../Filter.hh"
+#include "../Kernel.hh"
+#include "../Concepts.hh"
+#include "../../Data/Volume.hh"
+#include "../../GUI/Tree.hh"
+#include "../../GUI/Slider.hh"
+
+namespace opencl
+{
+    class Morphology : public Filter
+    {
+    public:
+        enum class Operation
+        {
+            Erode,
+            Dilate,
+            Open,
+            Close
+        };
+
+    private:
+        std::shared_ptr<opencl::Kernel> extract;
+        std::shared_ptr<opencl::Kernel> line;
+        std::shared_ptr<opencl::Kernel> insert;
+        cl_uint inlength;
+        cl_uint inwidth;
+        cl_uint indepth;
+        cl::Buffer inBuffer;
+        std::array<cl::Buffer, 2> alpha;
+        cl::Buffer scratch;
+        std::size_t scratchSize = 0;
+        std::shared_ptr<Operation> operation; // Shared with replicas, like the sliders
+        std::array<std::shared_ptr<gui::Slider>, 3> sliders;
+
+        std::array<cl_uint, 3> radii();
+        void pass(cl_uint dilate, cl_uint &src);
+
+    public:
+        cl::Context context;
+
+        const std::string in = "3D";
+        const std::string out = "3D";
+
+        Morphology(const Device &d);
+        ~Morphology() = default;
+
+        void input(const std::weak_ptr<data::Volume> &wv);
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+} // namespace opencl
+
+#endif
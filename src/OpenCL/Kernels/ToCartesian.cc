@@ -1,61 +1,150 @@
-#include "ToCartesian.hh"
-
-namespace opencl
-{
-
-    ToCartesian::ToCartesian(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr) : kernel(ptr), context(c), queue(q)
-    {
-        Filter::input = std::bind(input, this, std::placeholders::_1);
-        Filter::execute = std::bind(execute, this);
-        Filter::getOptions = std::bind(getOptions, this);
-    }
-
-    void ToCartesian::input(const std::weak_ptr<data::Volume> &wv)
-    {
-        auto v = wv.lock();
-        if (!v)
-            return;
-
-        volume->min = v->min;
-        volume->max = v->max;
-        inlength = v->length;
-        inwidth = v->width;
-        indepth = v->depth;
-        inBuffer = v->buffer;
-        volume->ratio = v->ratio;
-        volume->delta = v->delta;
-        volume->frames = v->frames;
-        volume->fRate = v->fRate;
-        volume->rFrame = v->rFrame;
-        volume->cFrame = v->cFrame;
-
-        volume->depth = indepth;
-        volume->width = inwidth;
-        volume->length = inlength;
-
-        volume->buffer = cl::Buffer(context, CL_MEM_READ_WRITE, volume->length * volume->depth * volume->width * sizeof(cl_uint));
-    }
-
-    void ToCartesian::execute()
-    {
-        kernel->setArg(0, indepth);
-        kernel->setArg(1, inlength);
-        kernel->setArg(2, inwidth);
-        kernel->setArg(3, inBuffer);
-        kernel->setArg(4, volume->depth);
-        kernel->setArg(5, volume->length);
-        kernel->setArg(6, volume->width);
-        kernel->setArg(7, volume->buffer);
-        kernel->setArg(8, volume->ratio);
-        kernel->setArg(9, volume->delta);
-
-        kernel->global = cl::NDRange(volume->depth, volume->length, volume->width);
-        kernel->execute(queue);
-    }
-
-    std::shared_ptr<gui::Tree> ToCartesian::getOptions()
-    {
-        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
-        return options;
-    }
-} // namespace opencl
+#include "ToCartesian.hh"
+
+#include <algorithm>
+
+#include "../Arena.hh"
+#include "../Device.hh"
+
+namespace opencl
+{
+
+    std::size_t ToCartesian::budget = 256u << 20;
+
+    ToCartesian::ToCartesian(const Device &d) : Filter(d.cQueue), build(d.programs.at("cartesian")->at("cartesianTable")), fanBuild(d.programs.at("cartesian")->at("fanTable")), gather(d.programs.at("cartesian")->at("scanConvert")), gatherImage(d.programs.at("cartesian")->at("scanConvertImage")), context(d.context)
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::replicate = [this](const Device &other) -> std::shared_ptr<Filter>
+        {
+            auto f = std::make_shared<ToCartesian>(other);
+            f->spacingSlider = spacingSlider;
+            return f;
+        };
+
+        spacingSlider = gui::Slider::build(0.0f, 0.0f, 0.0f, 10.0f);
+        spacingSlider->value = 1.0f / 3.0f;
+    }
+
+    // Isotropic grid over the bounding box of the fan, cropped to it rather than the full sphere. Spacing defaults
+    // to the axial sample spacing, the slider scales it from half to four times that.
+    bool ToCartesian::fanGrid(const data::Volume &v, cl_float slider, std::array<cl_uint, 3> &dims, std::array<cl_float, 4> &grid)
+    {
+        const std::array<cl_float, 2> &range = v.pointRange;
+        const std::array<cl_float, 2> &lines = v.lineRange;
+        if (!(range[1] > range[0]) || !(lines[1] > lines[0]) || v.depth < 2)
+            return false;
+
+        bool is3D = v.width > 1;
+        float half = v.delta / 2.0f;
+        float spread = std::tan(half);
+        float steer = std::tan(std::max(std::fabs(lines[0]), std::fabs(lines[1])));
+
+        // Nearest point of the fan along x is the corner of the first sample's shell. Lines need not sit
+        // symmetrically about the axis (steered or trimmed scans), width beams do.
+        float x0 = range[0] / std::sqrt(1.0f + steer * steer + (is3D ? spread * spread : 0.0f));
+        float y0 = std::min(range[0] * std::sin(lines[0]), range[1] * std::sin(lines[0]));
+        float y1 = std::max(range[0] * std::sin(lines[1]), range[1] * std::sin(lines[1]));
+        std::array<float, 3> extent = {range[1] - x0, y1 - y0, is3D ? 2.0f * range[1] * std::sin(half) : 0.0f};
+
+        float spacing = (range[1] - range[0]) / static_cast<float>(v.depth - 1) * 0.5f * std::pow(8.0f, slider);
+
+        auto count = [&](float s)
+        {
+            return std::array<cl_uint, 3>{
+                static_cast<cl_uint>(extent[0] / s) + 1,
+                static_cast<cl_uint>(extent[1] / s) + 1,
+                static_cast<cl_uint>(extent[2] / s) + 1};
+        };
+
+        // Coarsen until a frame fits the budget, voxels scale with the cube (square in 2D) of the spacing.
+        dims = count(spacing);
+        double bytes = static_cast<double>(dims[0]) * dims[1] * dims[2] * static_cast<double>(sizeof(cl_uint));
+        while (bytes > static_cast<double>(budget))
+        {
+            spacing *= static_cast<float>(std::max(std::pow(bytes / static_cast<double>(budget), is3D ? 1.0 / 3.0 : 1.0 / 2.0), 1.01));
+            dims = count(spacing);
+            bytes = static_cast<double>(dims[0]) * dims[1] * dims[2] * static_cast<double>(sizeof(cl_uint));
+        }
+
+        grid = {x0, y0, -extent[2] / 2.0f, spacing};
+        return true;
+    }
+
+    void ToCartesian::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return;
+
+        volume->min = v->min;
+        volume->max = v->max;
+        inlength = v->length;
+        inwidth = v->width;
+        indepth = v->depth;
+        inBuffer = v->buffer;
+        inImage = v->toImage(context, queue) ? v->image : cl::Image3D();
+        volume->ratio = v->ratio;
+        volume->delta = v->delta;
+        volume->frames = v->frames;
+        volume->fRate = v->fRate;
+        volume->rFrame = v->rFrame;
+        volume->cFrame = v->cFrame;
+        volume->batch = v->batch;
+
+        // Without the beam range fall back to the old grid, the input's dimensions over the unit sphere.
+        std::array<cl_uint, 3> dims = {indepth, inlength, inwidth};
+        bool physical = fanGrid(*v, spacingSlider->value, dims, grid);
+        range = physical ? v->pointRange : std::array<cl_float, 2>{0.0f, 0.0f};
+        lines = physical ? v->lineRange : std::array<cl_float, 2>{0.0f, 0.0f};
+        volume->depth = dims[0];
+        volume->length = dims[1];
+        volume->width = dims[2];
+        volume->pointRange = {0.0f, 0.0f};
+        volume->lineRange = {0.0f, 0.0f};
+
+        volume->buffer = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+    }
+
+    void ToCartesian::execute()
+    {
+        // Cached per geometry, only the first frame of a new geometry builds it
+        bool physical = range[1] > range[0];
+        ScanTable::Geometry g = {{indepth, inlength, inwidth}, {volume->depth, volume->length, volume->width}, volume->ratio, volume->delta};
+        if (physical)
+        {
+            g.grid = grid;
+            g.range = range;
+            g.lines = lines;
+        }
+        table = ScanTable::get(context, queue, physical ? *fanBuild : *build, g);
+
+        // Filtered image reads where the device has them, the manual trilinear blend otherwise
+        Kernel &k = inImage() != nullptr ? *gatherImage : *gather;
+
+        k.setArg(0, indepth);
+        k.setArg(1, inlength);
+        k.setArg(2, inwidth);
+        if (inImage() != nullptr)
+            k.setArg(3, inImage);
+        else
+            k.setArg(3, inBuffer);
+        k.setArg(4, volume->depth);
+        k.setArg(5, volume->length);
+        k.setArg(6, volume->width);
+        k.setArg(7, volume->buffer);
+        k.setArg(8, table->index);
+        k.setArg(9, table->weight);
+
+        k.global = cl::NDRange(volume->depth, volume->length, volume->width * volume->batch);
+        k.execute(queue);
+    }
+
+    std::shared_ptr<gui::Tree> ToCartesian::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+        spacingSlider->resize(0.0f, 0.0f, options->w, 0.0f);
+        options->addLeaf(spacingSlider);
+        return options;
+    }
+} // namespace opencl
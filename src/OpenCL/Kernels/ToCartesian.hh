@@ -1,44 +1,61 @@
-#ifndef OPENCL_TOCARTESIAN_HH
-#define OPENCL_TOCARTESIAN_HH
-
-#include <cmath>
-#include <memory>
-#include <string>
-
-#include <CL/cl2.hpp>
-
-#include "../Filter.hh"
-#include "../Kernel.hh"
-#include "../Concepts.hh"
-#include "../../Data/Volume.hh"
-#include "../../GUI/Tree.hh"
-
-namespace opencl
-{
-    class ToCartesian : public Filter
-    {
-    private:
-        std::shared_ptr<opencl::Kernel> kernel;
-        cl_uint inlength;
-        cl_uint inwidth;
-        cl_uint indepth;
-        cl::Buffer inBuffer;
-
-    public:
-        cl::Context context;
-        cl::CommandQueue queue;
-
-        const std::string in = "3D";
-        const std::string out = "3D";
-
-        ToCartesian(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr);
-        ~ToCartesian() = default;
-
-        void input(const std::weak_ptr<data::Volume> &wv);
-        void execute();
-        std::shared_ptr<gui::Tree> getOptions();
-    };
-
-} // namespace opencl
-
+#ifndef OPENCL_TOCARTESIAN_HH
+#define OPENCL_TOCARTESIAN_HH
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <CL/cl2.hpp>
+
+#include "../Filter.hh"
+#include "../Kernel.hh"
+#include "../ScanTable.hh"
+#include "../Concepts.hh"
+#include "../../Data/Volume.hh"
+#include "../../GUI/Tree.hh"
+#include "../../GUI/Slider.hh"
+
+namespace opencl
+{
+    class ToCartesian : public Filter
+    {
+    private:
+        std::shared_ptr<opencl::Kernel> build;
+        std::shared_ptr<opencl::Kernel> fanBuild;
+        std::shared_ptr<opencl::Kernel> gather;
+        std::shared_ptr<opencl::Kernel> gatherImage;
+        cl_uint inlength;
+        cl_uint inwidth;
+        cl_uint indepth;
+        cl::Buffer inBuffer;
+        cl::Image3D inImage; // Null when the input stays a buffer
+        std::shared_ptr<ScanTable> table;
+        std::shared_ptr<gui::Slider> spacingSlider;
+        std::array<cl_float, 4> grid;  // Origin and spacing of the output, only with a known beam range
+        std::array<cl_float, 2> range; // Beam distance of the first and last input sample, 0s without a grid
+        std::array<cl_float, 2> lines; // Beam angle of the first and last input line, 0s without a grid
+
+    public:
+        static std::size_t budget; // Output bytes per frame the spacing is coarsened to fit
+
+        // Output dimensions and grid (origin, spacing) for v, false when v has no beam or line range.
+        static bool fanGrid(const data::Volume &v, cl_float slider, std::array<cl_uint, 3> &dims, std::array<cl_float, 4> &grid);
+
+        cl::Context context;
+
+        const std::string in = "3D";
+        const std::string out = "3D";
+
+        ToCartesian(const Device &d);
+        ~ToCartesian() = default;
+
+        void input(const std::weak_ptr<data::Volume> &wv);
+        void execute();
+        std::shared_ptr<gui::Tree> getOptions();
+    };
+
+} // namespace opencl
+
 #endif
\ No newline at end of file
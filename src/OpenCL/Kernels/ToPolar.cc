@@ -1,65 +1,92 @@
-#include "ToPolar.hh"
-
-namespace opencl
-{
-
-    ToPolar::ToPolar(const cl::Context &c, const cl::CommandQueue &q, const std::shared_ptr<opencl::Kernel> &ptr) : kernel(ptr), context(c), queue(q)
-    {
-        Filter::input = std::bind(input, this, std::placeholders::_1);
-        Filter::execute = std::bind(execute, this);
-        Filter::getOptions = std::bind(getOptions, this);
-    }
-
-    void ToPolar::input(const std::weak_ptr<data::Volume> &wv)
-    {
-        auto v = wv.lock();
-        if (!v)
-            return;
-
-        volume->min = v->min;
-        volume->max = v->max;
-        inlength = v->length;
-        inwidth = v->width;
-        indepth = v->depth;
-        inBuffer = v->buffer;
-        volume->ratio = v->ratio;
-        volume->delta = v->delta;
-        volume->fRate = v->fRate;
-        volume->rFrame = v->rFrame;
-        volume->cFrame = v->cFrame;
-
-        volume->frames = v->frames;
-
-        volume->depth = static_cast<cl_uint>(static_cast<float>(v->depth) + (static_cast<float>(v->depth) * v->ratio) + 1.0f);
-        volume->length = static_cast<cl_uint>(2.0f * std::tan(v->delta / 2.0f) * static_cast<float>(volume->depth) + 1.0f);
-        volume->width = inwidth > 1 ? static_cast<cl_uint>(2.0f * std::tan(v->delta / 2.0f) * static_cast<float>(volume->depth) + 1.0f) : inwidth;
-        volume->depth -= static_cast<cl_uint>(static_cast<float>(v->depth) * v->ratio * std::cos(std::asin(std::sqrt(std::pow(std::sin(v->delta / 2.0f) * (static_cast<float>(v->depth) * v->ratio), 2) + std::pow(std::sin(v->delta / 2.0f) * (static_cast<float>(v->depth) * v->ratio), 2)) / (static_cast<float>(v->depth) * v->ratio))));
-
-        std::cout << volume->length << ' ' << volume->depth << ' ' << volume->width << std::endl;
-
-        volume->buffer = cl::Buffer(context, CL_MEM_READ_WRITE, volume->length * volume->depth * volume->width * sizeof(cl_uint));
-    }
-
-    void ToPolar::execute()
-    {
-        kernel->setArg(0, indepth);
-        kernel->setArg(1, inlength);
-        kernel->setArg(2, inwidth);
-        kernel->setArg(3, inBuffer);
-        kernel->setArg(4, volume->depth);
-        kernel->setArg(5, volume->length);
-        kernel->setArg(6, volume->width);
-        kernel->setArg(7, volume->buffer);
-        kernel->setArg(8, volume->ratio);
-        kernel->setArg(9, volume->delta);
-
-        kernel->global = cl::NDRange(volume->depth, volume->length, volume->width);
-        kernel->execute(queue);
-    }
-
-    std::shared_ptr<gui::Tree> ToPolar::getOptions()
-    {
-        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
-        return options;
-    }
-} // namespace opencl
+#include "ToPolar.hh"
+
+#include "../Arena.hh"
+#include "../Device.hh"
+
+namespace opencl
+{
+
+    ToPolar::ToPolar(const Device &d) : Filter(d.cQueue), build(d.programs.at("cartesian")->at("sphericalTable")), gather(d.programs.at("cartesian")->at("scanConvert")), gatherImage(d.programs.at("cartesian")->at("scanConvertImage")), context(d.context)
+    {
+        Filter::input = std::bind(input, this, std::placeholders::_1);
+        Filter::execute = std::bind(execute, this);
+        Filter::getOptions = std::bind(getOptions, this);
+        Filter::replicate = [](const Device &other) -> std::shared_ptr<Filter>
+        { return std::make_shared<ToPolar>(other); };
+    }
+
+    // Sphere section around the fan, in input samples.
+    std::array<cl_uint, 3> ToPolar::outputShape(const data::Volume &v)
+    {
+        cl_uint d = static_cast<cl_uint>(static_cast<float>(v.depth) + (static_cast<float>(v.depth) * v.ratio) + 1.0f);
+        cl_uint l = static_cast<cl_uint>(2.0f * std::tan(v.delta / 2.0f) * static_cast<float>(d) + 1.0f);
+        cl_uint w = v.width > 1 ? static_cast<cl_uint>(2.0f * std::tan(v.delta / 2.0f) * static_cast<float>(d) + 1.0f) : v.width;
+        d -= static_cast<cl_uint>(static_cast<float>(v.depth) * v.ratio * std::cos(std::asin(std::sqrt(std::pow(std::sin(v.delta / 2.0f) * (static_cast<float>(v.depth) * v.ratio), 2) + std::pow(std::sin(v.delta / 2.0f) * (static_cast<float>(v.depth) * v.ratio), 2)) / (static_cast<float>(v.depth) * v.ratio))));
+
+        return {d, l, w};
+    }
+
+    void ToPolar::input(const std::weak_ptr<data::Volume> &wv)
+    {
+        auto v = wv.lock();
+        if (!v)
+            return;
+
+        volume->min = v->min;
+        volume->max = v->max;
+        inlength = v->length;
+        inwidth = v->width;
+        indepth = v->depth;
+        inBuffer = v->buffer;
+        inImage = v->toImage(context, queue) ? v->image : cl::Image3D();
+        volume->ratio = v->ratio;
+        volume->delta = v->delta;
+        volume->fRate = v->fRate;
+        volume->rFrame = v->rFrame;
+        volume->cFrame = v->cFrame;
+        volume->batch = v->batch;
+
+        volume->frames = v->frames;
+
+        auto dims = outputShape(*v);
+        volume->depth = dims[0];
+        volume->length = dims[1];
+        volume->width = dims[2];
+
+        std::cout << volume->length << ' ' << volume->depth << ' ' << volume->width << std::endl;
+
+        volume->buffer = Arena::allocate(context, volume->length * volume->depth * volume->width * volume->batch * sizeof(cl_uint));
+    }
+
+    void ToPolar::execute()
+    {
+        // Cached per geometry, only the first frame of a new geometry builds it
+        table = ScanTable::get(context, queue, *build, {{indepth, inlength, inwidth}, {volume->depth, volume->length, volume->width}, volume->ratio, volume->delta});
+
+        // Filtered image reads where the device has them, the manual trilinear blend otherwise
+        Kernel &k = inImage() != nullptr ? *gatherImage : *gather;
+
+        k.setArg(0, indepth);
+        k.setArg(1, inlength);
+        k.setArg(2, inwidth);
+        if (inImage() != nullptr)
+            k.setArg(3, inImage);
+        else
+            k.setArg(3, inBuffer);
+        k.setArg(4, volume->depth);
+        k.setArg(5, volume->length);
+        k.setArg(6, volume->width);
+        k.setArg(7, volume->buffer);
+        k.setArg(8, table->index);
+        k.setArg(9, table->weight);
+
+        k.global = cl::NDRange(volume->depth, volume->length, volume->width * volume->batch);
+        k.execute(queue);
+    }
+
+    std::shared_ptr<gui::Tree> ToPolar::getOptions()
+    {
+        std::shared_ptr<gui::Tree> options = gui::Tree::build("OPTIONS");
+        return options;
+    }
+} // namespace opencl
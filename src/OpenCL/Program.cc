@@ -1,52 +1,205 @@
-#include "Program.hh"
-
-#include <string>
-#include <string_view>
-#include <fstream>
-
-#include "Source.hh"
-
-namespace opencl
-{
-    
-
-
-Program::Program(cl::Context context, Source src) : program(context, src), name(std::string_view(src.name).substr(src.name.find_last_of('/') + 1, src.name.find_last_of('.')))
-{
-    try
-    {
-        program.build("-cl-kernel-arg-info");
-        std::vector<cl::Kernel> kernelVec;
-        program.createKernels(&kernelVec);
-        for (auto &&k : kernelVec)
-        {
-            kernels.emplace(k.getInfo<CL_KERNEL_FUNCTION_NAME>(), std::make_shared<Kernel>(k));
-        }
-    }
-    catch(const cl::BuildError& e)
-    {
-        std::cerr << e.err() << ": " << e.what() << '\n';
-        std::fstream fout;
-        fout.open(std::string("./build/logs/") + name + std::string(".txt"), std::fstream::out);
-        for (auto &str : e.getBuildLog())
-        {
-            fout << str.second << '\n';
-        }
-    }
-}
-
-Program::~Program()
-{
-}
-
-std::shared_ptr<Kernel> &Program::at(std::string str)
-{
-    return kernels.at(str);
-}
-
-// cl::Program *Program::operator->()
-// {
-//     return &program;
-// }
-
+#include "Program.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <fstream>
+
+#include "Source.hh"
+
+namespace
+{
+    // FNV-1a, stable across runs and compilers unlike std::hash.
+    std::string cacheKey(const cl::Device &device, const std::string &options, const std::string &text)
+    {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        auto mix = [&h](std::string_view sv)
+        {
+            for (char c : sv)
+            {
+                h ^= static_cast<unsigned char>(c);
+                h *= 0x100000001b3ull;
+            }
+            h ^= 0xFF; // Field separator
+            h *= 0x100000001b3ull;
+        };
+
+        mix(cl::Platform(device.getInfo<CL_DEVICE_PLATFORM>()).getInfo<CL_PLATFORM_NAME>());
+        mix(device.getInfo<CL_DEVICE_NAME>());
+        mix(device.getInfo<CL_DRIVER_VERSION>());
+        mix(options);
+        mix(text);
+
+        std::ostringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << h;
+        return ss.str();
+    }
+}
+
+namespace opencl
+{
+    
+std::string Program::cacheDir = "./build/cache/";
+bool Program::specialisation = true;
+std::size_t Program::variantLimit = 4;
+
+Program::Program(cl::Context c, Source src, const std::string &opts) : context(c), source(src), options(opts), generic(options.find("-DDEPTH") == std::string::npos), name(std::string_view(src.name).substr(src.name.find_last_of('/') + 1, src.name.find_last_of('.')))
+{
+    try
+    {
+        cl::Device device = context.getInfo<CL_CONTEXT_DEVICES>().front();
+        std::string base = cacheDir + name + '-' + cacheKey(device, options, src.text);
+
+        std::map<std::string, std::vector<Kernel::Arg>> args;
+
+        bool cached = loadBinary(device, base);
+        if (cached)
+        {
+            // Argument info is only guaranteed for programs built from source, it is cached beside the binary.
+            // One tab separated line per argument: kernel, name, type, address qualifier, access qualifier.
+            std::ifstream fin(base + ".args");
+            std::string line;
+            while (std::getline(fin, line))
+            {
+                std::istringstream ss(line);
+                std::string kName, address, access;
+                Kernel::Arg a;
+                if (std::getline(ss, kName, '\t') && std::getline(ss, a.name, '\t') && std::getline(ss, a.type, '\t') && std::getline(ss, address, '\t') && std::getline(ss, access))
+                {
+                    a.address = static_cast<cl_kernel_arg_address_qualifier>(std::stoul(address));
+                    a.access = static_cast<cl_kernel_arg_access_qualifier>(std::stoul(access));
+                    args[kName].push_back(std::move(a));
+                }
+            }
+        }
+        else
+        {
+            program = cl::Program(context, src);
+            program.build(options.c_str());
+        }
+
+        std::vector<cl::Kernel> kernelVec;
+        program.createKernels(&kernelVec);
+        for (auto &&k : kernelVec)
+        {
+            std::string kName = k.getInfo<CL_KERNEL_FUNCTION_NAME>();
+            kernels.emplace(kName, std::make_shared<Kernel>(k, args[kName], generic ? this : nullptr));
+        }
+
+        if (!cached)
+            saveBinary(base);
+    }
+    catch(const cl::BuildError& e)
+    {
+        std::cerr << e.err() << ": " << e.what() << '\n';
+        std::fstream fout;
+        fout.open(std::string("./build/logs/") + name + std::string(".txt"), std::fstream::out);
+        for (auto &str : e.getBuildLog())
+        {
+            fout << str.second << '\n';
+        }
+    }
+}
+
+Program::~Program()
+{
+}
+
+cl::Kernel Program::variant(const std::string &kernel, cl_uint depth, cl_uint length, cl_uint width)
+{
+    if (!specialisation || !generic)
+        return cl::Kernel();
+
+    std::array<cl_uint, 3> shape = {depth, length, width};
+    std::lock_guard<std::mutex> guard(variantLock);
+
+    auto itr = std::find_if(variants.begin(), variants.end(), [&shape](const auto &v)
+                            { return v.first == shape; });
+    if (itr != variants.end())
+    {
+        variants.splice(variants.begin(), variants, itr);
+    }
+    else
+    {
+        std::string defines = options + " -DDEPTH=" + std::to_string(depth) + "u -DLENGTH=" + std::to_string(length) + "u -DWIDTH=" + std::to_string(width) + "u";
+        std::cout << "Specialising " << name << " for " << depth << 'x' << length << 'x' << width << std::endl;
+
+        auto p = std::make_shared<Program>(context, source, defines);
+        if (p->kernels.empty())
+            p = nullptr; // Build failed, this shape keeps the generic kernels
+
+        variants.emplace_front(shape, p);
+        if (variants.size() > variantLimit)
+            variants.pop_back();
+    }
+
+    const auto &p = variants.front().second;
+    if (!p || !p->kernels.contains(kernel))
+        return cl::Kernel();
+
+    return *p->kernels.at(kernel);
+}
+
+bool Program::loadBinary(const cl::Device &device, const std::string &base)
+{
+    std::ifstream fin(base + ".bin", std::ios::binary);
+    if (!fin || !std::filesystem::exists(base + ".args"))
+        return false;
+
+    std::vector<unsigned char> binary((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+    if (binary.empty())
+        return false;
+
+    try
+    {
+        std::vector<cl_int> status;
+        program = cl::Program(context, {device}, cl::Program::Binaries{binary}, &status);
+        program.build({device}, options.c_str());
+        std::cout << "Cached: " << name << std::endl;
+        return true;
+    }
+    catch (const cl::Error &e)
+    {
+        // Stale or rejected binary (driver update the key missed), rebuild from source.
+        std::cerr << "Binary cache miss, " << name << " : " << e.err() << '\n';
+        return false;
+    }
+}
+
+void Program::saveBinary(const std::string &base)
+{
+    auto binaries = program.getInfo<CL_PROGRAM_BINARIES>();
+    if (binaries.empty() || binaries.front().empty())
+        return;
+
+    std::filesystem::create_directories(std::filesystem::path(base).parent_path());
+
+    std::ofstream fbin(base + ".bin", std::ios::binary | std::ios::trunc);
+    fbin.write(reinterpret_cast<const char *>(binaries.front().data()), static_cast<std::streamsize>(binaries.front().size()));
+
+    std::ofstream fargs(base + ".args", std::ios::trunc);
+    for (const auto &[kName, k] : kernels)
+    {
+        for (const Kernel::Arg &a : k->args())
+        {
+            fargs << kName << '\t' << a.name << '\t' << a.type << '\t' << a.address << '\t' << a.access << '\n';
+        }
+    }
+}
+
+std::shared_ptr<Kernel> &Program::at(std::string str)
+{
+    return kernels.at(str);
+}
+
+// cl::Program *Program::operator->()
+// {
+//     return &program;
+// }
+
 } // namespace opencl
\ No newline at end of file
@@ -1,31 +1,53 @@
-#ifndef OPENCL_PROGRAM_HH
-#define OPENCL_PROGRAM_HH
-
-#include <string>
-#include <map>
-#include <memory>
-
-#include <CL/cl2.hpp>
-
-#include "Kernel.hh"
-#include "Source.hh"
-
-namespace opencl
-{
-    class Program
-    {
-    private:
-        cl::Program program;
-
-    public:
-        std::map<std::string, std::shared_ptr<Kernel>> kernels;
-        std::string name;
-
-        Program(cl::Context context, Source src);
-        ~Program();
-
-        std::shared_ptr<Kernel> &at(std::string str);
-    };
-} // namespace opencl
-
+#ifndef OPENCL_PROGRAM_HH
+#define OPENCL_PROGRAM_HH
+
+#include <array>
+#include <list>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <CL/cl2.hpp>
+
+#include "Kernel.hh"
+#include "Source.hh"
+
+namespace opencl
+{
+    class Program
+    {
+    private:
+        cl::Program program;
+        cl::Context context;
+        Source source;
+        std::string options;
+        bool generic;
+
+        // Rebuilds with the volume shape baked in, most recently used first. Null marks a failed build.
+        std::list<std::pair<std::array<cl_uint, 3>, std::shared_ptr<Program>>> variants;
+        std::mutex variantLock;
+
+        bool loadBinary(const cl::Device &device, const std::string &base);
+        void saveBinary(const std::string &base);
+
+    public:
+        static std::string cacheDir;
+        static bool specialisation;
+        static std::size_t variantLimit;
+
+        std::map<std::string, std::shared_ptr<Kernel>> kernels;
+        std::string name;
+
+        Program(cl::Context c, Source src, const std::string &opts = "-cl-kernel-arg-info");
+        ~Program();
+
+        std::shared_ptr<Kernel> &at(std::string str);
+
+        // Returns the named kernel built for this shape, or a null kernel when the generic one should be used.
+        cl::Kernel variant(const std::string &kernel, cl_uint depth, cl_uint length, cl_uint width);
+    };
+} // namespace opencl
+
 #endif
\ No newline at end of file
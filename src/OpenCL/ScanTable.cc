@@ -0,0 +1,75 @@
+#include "ScanTable.hh"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+#include "Arena.hh"
+
+namespace opencl
+{
+
+    std::size_t ScanTable::limit = 4;
+    std::mutex ScanTable::lock;
+    std::list<std::pair<ScanTable::key_t, std::shared_ptr<ScanTable>>> ScanTable::cache;
+
+    std::shared_ptr<ScanTable> ScanTable::get(const cl::Context &context, cl::CommandQueue &cQueue, Kernel &build, const Geometry &g)
+    {
+        std::array<cl_float, 10> floats = {g.ratio, g.delta, g.grid[0], g.grid[1], g.grid[2], g.grid[3], g.range[0], g.range[1], g.lines[0], g.lines[1]};
+        key_t key = {context(), build.name(), g.in, g.out, std::bit_cast<std::array<std::uint32_t, 10>>(floats)};
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        auto itr = std::find_if(cache.begin(), cache.end(), [&key](const auto &c)
+                                { return c.first == key; });
+        if (itr != cache.end())
+        {
+            cache.splice(cache.begin(), cache, itr);
+            return cache.front().second;
+        }
+
+        std::size_t voxels = std::size_t(g.out[0]) * g.out[1] * g.out[2];
+
+        auto table = std::make_shared<ScanTable>();
+        try
+        {
+            table->index = Arena::allocate(context, voxels * sizeof(cl_uint));
+            table->weight = Arena::allocate(context, voxels * sizeof(cl_uchar4));
+
+            build.setArg(0, g.in[0]);
+            build.setArg(1, g.in[1]);
+            build.setArg(2, g.in[2]);
+            build.setArg(3, g.out[0]);
+            build.setArg(4, g.out[1]);
+            build.setArg(5, g.out[2]);
+            build.setArg(6, g.ratio);
+            build.setArg(7, g.delta);
+            build.setArg(8, table->index);
+            build.setArg(9, table->weight);
+            if (build.numArgs() > 10)
+            {
+                build.setArg(10, cl_float4{{g.grid[0], g.grid[1], g.grid[2], g.grid[3]}});
+                build.setArg(11, cl_float2{{g.range[0], g.range[1]}});
+                build.setArg(12, cl_float2{{g.lines[0], g.lines[1]}});
+            }
+
+            build.global = cl::NDRange(g.out[0], g.out[1], g.out[2]);
+            build.execute(cQueue);
+            // Other queues (graph branches, other filters) read the table with nothing to order them behind
+            // this build, so wait for it, once per new geometry.
+            cQueue.finish();
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Scan table, " << e.what() << " : " << e.err() << '\n';
+            std::terminate();
+        }
+
+        cache.emplace_front(key, table);
+        if (cache.size() > limit)
+            cache.pop_back();
+
+        return table;
+    }
+
+} // namespace opencl
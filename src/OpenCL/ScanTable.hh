@@ -0,0 +1,53 @@
+#ifndef OPENCL_SCANTABLE_HH
+#define OPENCL_SCANTABLE_HH
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include <CL/cl2.hpp>
+
+#include "Kernel.hh"
+
+namespace opencl
+{
+
+    // Scan-conversion lookup table, a source cell index and trilinear fractions per output voxel. Built once per
+    // probe geometry and shared by every frame, filter and exam that uses it.
+    class ScanTable
+    {
+    public:
+        struct Geometry
+        {
+            std::array<cl_uint, 3> in;
+            std::array<cl_uint, 3> out;
+            cl_float ratio;
+            cl_float delta;
+            std::array<cl_float, 4> grid = {0.0f, 0.0f, 0.0f, 0.0f}; // fanTable only, origin and spacing
+            std::array<cl_float, 2> range = {0.0f, 0.0f};             // fanTable only, beam distance of first and last sample
+            std::array<cl_float, 2> lines = {0.0f, 0.0f};             // fanTable only, beam angle of first and last line
+        };
+
+        cl::Buffer index;
+        cl::Buffer weight;
+
+        static std::size_t limit;
+
+        // build is sphericalTable, cartesianTable or fanTable from cartesian.cl.
+        static std::shared_ptr<ScanTable> get(const cl::Context &context, cl::CommandQueue &cQueue, Kernel &build, const Geometry &g);
+
+    private:
+        // Context, builder, dimensions and the float bits of ratio, delta, grid, range and lines
+        using key_t = std::tuple<cl_context, std::string, std::array<cl_uint, 3>, std::array<cl_uint, 3>, std::array<std::uint32_t, 10>>;
+
+        static std::mutex lock;
+        static std::list<std::pair<key_t, std::shared_ptr<ScanTable>>> cache; // Most recently used first
+    };
+
+} // namespace opencl
+
+#endif
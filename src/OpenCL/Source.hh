@@ -1,27 +1,28 @@
-#ifndef OPENCL_SOURCE_HH
-#define OPENCL_SOURCE_HH
-
-#include <string>
-
-#include <CL/cl2.hpp>
-
-namespace opencl
-{
-
-    class Source
-    {
-    private:
-        cl::Program::Sources src;
-
-    public:
-        std::string name;
-
-        Source(const std::string &url);
-        ~Source();
-
-        operator cl::Program::Sources();
-    };
-
-} // namespace opencl
-
+#ifndef OPENCL_SOURCE_HH
+#define OPENCL_SOURCE_HH
+
+#include <string>
+
+#include <CL/cl2.hpp>
+
+namespace opencl
+{
+
+    class Source
+    {
+    private:
+        cl::Program::Sources src;
+
+    public:
+        std::string name;
+        std::string text;
+
+        Source(const std::string &url);
+        ~Source();
+
+        operator cl::Program::Sources();
+    };
+
+} // namespace opencl
+
 #endif
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "Tuner.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "Kernel.hh"
+
+namespace
+{
+    // Keys tuned during this run, --retune only redoes each of these once.
+    std::set<std::string> fresh;
+
+    std::size_t sizeClass(std::size_t n)
+    {
+        std::size_t c = 1;
+        while (c < n)
+            c <<= 1;
+        return c;
+    }
+}
+
+namespace opencl
+{
+
+    std::map<std::string, Tuner::local_t> Tuner::table;
+    std::mutex Tuner::lock;
+    std::string Tuner::path = "./build/tuning.txt";
+    bool Tuner::enabled = true;
+    bool Tuner::retune = false;
+
+    std::string Tuner::key(const cl::Kernel &kernel, const cl::Device &device, const cl::NDRange &global)
+    {
+        std::ostringstream ss;
+        ss << device.getInfo<CL_DEVICE_NAME>() << '|' << kernel.getInfo<CL_KERNEL_FUNCTION_NAME>() << '|';
+        for (std::size_t i = 0; i < global.dimensions(); ++i)
+        {
+            ss << (i ? "x" : "") << sizeClass(global[i]);
+        }
+        return ss.str();
+    }
+
+    cl::NDRange Tuner::toRange(const local_t &l, std::size_t dims)
+    {
+        if (l[0] == 0)
+            return cl::NullRange;
+
+        switch (dims)
+        {
+        case 1:
+            return cl::NDRange(l[0]);
+        case 2:
+            return cl::NDRange(l[0], l[1]);
+        default:
+            return cl::NDRange(l[0], l[1], l[2]);
+        }
+    }
+
+    Tuner::local_t Tuner::tune(Kernel &k, cl::CommandQueue &cQueue, const cl::Device &device, const cl::NDRange &global)
+    {
+        static const std::vector<local_t> candidates1D = {{32, 1, 1}, {64, 1, 1}, {128, 1, 1}, {256, 1, 1}};
+        static const std::vector<local_t> candidates2D = {{8, 8, 1}, {16, 8, 1}, {16, 16, 1}, {32, 4, 1}, {32, 8, 1}, {64, 4, 1}};
+        static const std::vector<local_t> candidates3D = {{4, 4, 4}, {8, 4, 4}, {8, 8, 4}, {16, 4, 4}, {8, 8, 1}, {16, 8, 1}, {32, 4, 1}, {16, 16, 1}, {32, 8, 1}};
+
+        cl::Kernel kernel = k;
+        std::size_t dims = global.dimensions();
+        const auto &candidates = dims == 1 ? candidates1D : (dims == 2 ? candidates2D : candidates3D);
+
+        std::size_t maxGroup = kernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(device);
+        std::vector<std::size_t> maxItems = device.getInfo<CL_DEVICE_MAX_WORK_ITEM_SIZES>();
+
+        auto measure = [&](const cl::NDRange &range)
+        {
+            float best = std::numeric_limits<float>::max();
+            for (int r = 0; r < 3; ++r)
+            {
+                cQueue.finish();
+                auto start = std::chrono::steady_clock::now();
+                cQueue.enqueueNDRangeKernel(kernel, cl::NullRange, global, range);
+                cQueue.finish();
+                auto stop = std::chrono::steady_clock::now();
+                best = std::min(best, std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(stop - start).count());
+            }
+            return best;
+        };
+
+        // Candidates run on copies of the bound buffers, in-place kernels (gaussianIIR, integralLine) would
+        // otherwise apply themselves to the live data once per timing run.
+        cl::Context context = cQueue.getInfo<CL_QUEUE_CONTEXT>();
+        std::map<unsigned int, cl::Buffer> originals = k.buffers, copies;
+        auto bind = [&kernel](const std::map<unsigned int, cl::Buffer> &buffers)
+        {
+            for (const auto &[pos, b] : buffers)
+                kernel.setArg(pos, b);
+        };
+
+        try
+        {
+            for (const auto &[pos, b] : originals)
+            {
+                std::size_t size = b.getInfo<CL_MEM_SIZE>();
+                cl::Buffer copy(context, CL_MEM_READ_WRITE, size);
+                cQueue.enqueueCopyBuffer(b, copy, 0, 0, size);
+                copies.emplace(pos, copy);
+            }
+        }
+        catch (const cl::Error &e)
+        {
+            std::cerr << "Tuner, no room to copy the arguments of " << k.name() << ", left to the driver : " << e.err() << '\n';
+            return {0, 0, 0};
+        }
+        bind(copies);
+
+        local_t chosen = {0, 0, 0};
+        float bestTime = measure(cl::NullRange);
+        float nullTime = bestTime;
+
+        for (const local_t &l : candidates)
+        {
+            // OpenCL 1.2 needs the global size to be a multiple of the local size.
+            bool valid = l[0] * l[1] * l[2] <= maxGroup;
+            for (std::size_t i = 0; i < dims && valid; ++i)
+            {
+                valid = l[i] <= maxItems.at(i) && global[i] % l[i] == 0;
+            }
+            if (!valid)
+                continue;
+
+            try
+            {
+                float t = measure(toRange(l, dims));
+                if (t < bestTime)
+                {
+                    bestTime = t;
+                    chosen = l;
+                }
+            }
+            catch (const cl::Error &e)
+            {
+                // Kernel resources can rule out a local size the device limits allow, skip it.
+            }
+        }
+
+        cQueue.finish();
+        bind(originals);
+
+        // Timings only for --retune, report() lists the chosen sizes at exit either way.
+        if (retune)
+            std::cout << "Tuned " << k.name() << ": " << chosen[0] << 'x' << chosen[1] << 'x' << chosen[2] << " (" << bestTime << "ms, driver choice " << nullTime << "ms)" << std::endl;
+
+        return chosen;
+    }
+
+    cl::NDRange Tuner::local(Kernel &kernel, cl::CommandQueue &cQueue, const cl::NDRange &global)
+    {
+        if (!enabled)
+            return cl::NullRange;
+
+        local_t classes = {0, 0, 0};
+        for (std::size_t i = 0; i < global.dimensions(); ++i)
+        {
+            classes[i] = sizeClass(global[i]);
+        }
+
+        Cache &cache = kernel.tuning;
+        if (cache.queue != cQueue() || cache.classes != classes)
+        {
+            cl::Device device = cQueue.getInfo<CL_QUEUE_DEVICE>();
+            std::string k = key(kernel, device, global);
+
+            std::lock_guard<std::mutex> guard(lock);
+
+            auto itr = table.find(k);
+            if (itr == table.end() || (retune && !fresh.contains(k)))
+            {
+                table[k] = tune(kernel, cQueue, device, global);
+                fresh.insert(k);
+                save();
+                itr = table.find(k);
+            }
+            cache = {cQueue(), classes, itr->second};
+        }
+
+        // A size class covers several exact sizes, the stored size may not divide this one.
+        const local_t &l = cache.local;
+        for (std::size_t i = 0; i < global.dimensions(); ++i)
+        {
+            if (l[i] != 0 && global[i] % l[i] != 0)
+                return cl::NullRange;
+        }
+
+        return toRange(l, global.dimensions());
+    }
+
+    void Tuner::load()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        std::ifstream fin(path);
+        std::string line;
+        while (std::getline(fin, line))
+        {
+            std::istringstream ss(line);
+            local_t l;
+            std::string k;
+            if (ss >> l[0] >> l[1] >> l[2] && std::getline(ss >> std::ws, k))
+            {
+                table[k] = l;
+            }
+        }
+    }
+
+    void Tuner::save()
+    {
+        std::filesystem::path p(path);
+        if (p.has_parent_path())
+            std::filesystem::create_directories(p.parent_path());
+
+        std::ofstream fout(path, std::ofstream::trunc);
+        for (const auto &[k, l] : table)
+        {
+            fout << l[0] << ' ' << l[1] << ' ' << l[2] << ' ' << k << '\n';
+        }
+    }
+
+    void Tuner::report()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        std::cout << "Local work sizes (device|kernel|size class):\n";
+        for (const auto &[k, l] : table)
+        {
+            std::cout << "  " << k << " -> ";
+            if (l[0] == 0)
+                std::cout << "driver";
+            else
+                std::cout << l[0] << 'x' << l[1] << 'x' << l[2];
+            std::cout << (fresh.contains(k) ? " (tuned)" : "") << '\n';
+        }
+        std::cout << std::flush;
+    }
+
+} // namespace opencl
@@ -0,0 +1,53 @@
+#ifndef OPENCL_TUNER_HH
+#define OPENCL_TUNER_HH
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <CL/cl2.hpp>
+
+namespace opencl
+{
+    class Kernel;
+
+    // Picks a local work size per (device, kernel, problem size class) by timing candidates on first use.
+    // Results persist in a small text database so later runs skip the timing.
+    class Tuner
+    {
+    public:
+        using local_t = std::array<std::size_t, 3>; // {0, 0, 0} is cl::NullRange
+
+        // Kept on each Kernel, enqueues on the same queue and size classes skip the key and the lock.
+        struct Cache
+        {
+            cl_command_queue queue = nullptr;
+            local_t classes = {0, 0, 0};
+            local_t local = {0, 0, 0};
+        };
+
+    private:
+
+        static std::map<std::string, local_t> table;
+        static std::mutex lock;
+
+        static std::string key(const cl::Kernel &kernel, const cl::Device &device, const cl::NDRange &global);
+        static local_t tune(Kernel &kernel, cl::CommandQueue &cQueue, const cl::Device &device, const cl::NDRange &global);
+        static cl::NDRange toRange(const local_t &l, std::size_t dims);
+
+    public:
+        static std::string path;
+        static bool enabled;
+        static bool retune;
+
+        static void load();
+        static void save();
+        static void report();
+
+        static cl::NDRange local(Kernel &kernel, cl::CommandQueue &cQueue, const cl::NDRange &global);
+    };
+
+} // namespace opencl
+
+#endif
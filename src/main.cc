@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <cstdlib>
 #include <iostream>
+#include <string_view>
 #include <thread>
 #include <chrono>
 
@@ -12,8 +15,13 @@
 #include "GUI/Dropzone.hh"
 #include "GUI/Renderer.hh"
 
+#include "OpenCL/Arena.hh"
+#include "OpenCL/Benchmark.hh"
 #include "OpenCL/Device.hh"
+#include "OpenCL/DeviceGroup.hh"
 #include "OpenCL/Kernel.hh"
+#include "OpenCL/Program.hh"
+#include "OpenCL/Tuner.hh"
 
 #include "OpenCL/Kernels/ToPolar.hh"
 #include "OpenCL/Kernels/ToCartesian.hh"
@@ -29,12 +37,17 @@
 #include "OpenCL/Kernels/Threshold.hh"
 #include "OpenCL/Kernels/MedianNoise.hh"
 #include "OpenCL/Kernels/Gaussian.hh"
+#include "OpenCL/Kernels/Morphology.hh"
+#include "OpenCL/Kernels/Box.hh"
 
 #include "IO/InfoStore.hh"
 #include "IO/Types/Binary.hh"
 #include "IO/Types/Nifti1.hh"
 #include "Ultrasound/Mindray.hh"
 
+#include "Native/Filters.hh"
+
+#include "Data/FrameCache.hh"
 #include "Data/Volume.hh"
 
 #include "glm/ext.hpp"
@@ -44,6 +57,96 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
 
     std::ios::sync_with_stdio(false);
 
+    // --group: also build every CPU/accelerator device for frame-parallel export.
+    // --round-robin: fixed frame distribution across the group instead of work stealing.
+    // --serial: export one frame at a time instead of through the staged pipeline.
+    // --batch N: frames per enqueue when exporting (default picks from the volume size, 1 matches the old path).
+    // --slab MB: export frames whose filter chain needs more device memory than this in z-slabs (default the smaller of the device's largest buffer and the arena budget).
+    // --retune: time local work sizes again instead of using ./build/tuning.txt. --no-tune: leave them to the driver.
+    // --no-specialise: always run the generic kernels instead of builds with the volume shape baked in.
+    // --scan-budget MB: largest scan-converted frame, the output spacing is coarsened to fit (default 256).
+    // --no-images: read volumes from buffers everywhere instead of filtered Image3D reads.
+    // --bench: time the tiled neighbourhood kernels against the untiled reference ones (bench/reference.cl, only built then), and the pointwise kernels per work-item span, after start up.
+    // --no-wide: keep CPU devices on the one voxel per work-item pointwise kernels.
+    // --frame-cache MB: device memory for frames kept by nodes with CACHE on (default 256). --frame-spill MB: host memory past that (default 1024).
+    // --arena MB: device memory for filter outputs and scratch, cached frames are spilled to stay under it (default 1024).
+    // --native: run the filters and rendering on the host even with an OpenCL platform (automatic without one).
+    bool useGroup = false;
+    bool useNative = false;
+    bool bench = false;
+    bool pipelined = true;
+    cl_uint batch = 0;
+    std::size_t slab = 0;
+    opencl::DeviceGroup group;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg(argv[i]);
+        if (arg == "--group")
+        {
+            useGroup = true;
+        }
+        else if (arg == "--round-robin")
+        {
+            group.schedule = opencl::DeviceGroup::Schedule::RoundRobin;
+        }
+        else if (arg == "--serial")
+        {
+            pipelined = false;
+        }
+        else if (arg == "--retune")
+        {
+            opencl::Tuner::retune = true;
+        }
+        else if (arg == "--no-tune")
+        {
+            opencl::Tuner::enabled = false;
+        }
+        else if (arg == "--bench")
+        {
+            bench = true;
+        }
+        else if (arg == "--no-specialise")
+        {
+            opencl::Program::specialisation = false;
+        }
+        else if (arg == "--batch" && i + 1 < argc)
+        {
+            batch = static_cast<cl_uint>(std::max(std::atoi(argv[++i]), 1));
+        }
+        else if (arg == "--slab" && i + 1 < argc)
+        {
+            slab = static_cast<std::size_t>(std::max(std::atoi(argv[++i]), 1)) << 20;
+        }
+        else if (arg == "--no-images")
+        {
+            data::Volume::useImages = false;
+        }
+        else if (arg == "--no-wide")
+        {
+            opencl::Device::wideKernels = false;
+        }
+        else if (arg == "--native")
+        {
+            useNative = true;
+        }
+        else if (arg == "--frame-cache" && i + 1 < argc)
+        {
+            data::FrameCache::deviceBudget = static_cast<std::size_t>(std::max(std::atoi(argv[++i]), 0)) << 20;
+        }
+        else if (arg == "--frame-spill" && i + 1 < argc)
+        {
+            data::FrameCache::hostBudget = static_cast<std::size_t>(std::max(std::atoi(argv[++i]), 0)) << 20;
+        }
+        else if (arg == "--arena" && i + 1 < argc)
+        {
+            opencl::Arena::budget = static_cast<std::size_t>(std::max(std::atoi(argv[++i]), 1)) << 20;
+        }
+        else if (arg == "--scan-budget" && i + 1 < argc)
+        {
+            opencl::ToCartesian::budget = static_cast<std::size_t>(std::max(std::atoi(argv[++i]), 1)) << 20;
+        }
+    }
+
     using gui::Window;
 
     gui::Instance init;
@@ -61,6 +164,29 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
 
     opencl::Device device;
 
+    if (!useNative)
+    {
+        std::vector<cl::Platform> platforms;
+        try
+        {
+            cl::Platform::get(&platforms);
+        }
+        catch (const cl::Error &)
+        {
+            platforms.clear(); // No ICD installed
+        }
+
+        if (platforms.empty())
+        {
+            std::cout << "No OpenCL platform, using the native backend." << std::endl;
+            useNative = true;
+        }
+    }
+
+    device.native = useNative;
+    device.selected = useNative;
+
+    if (!useNative)
     {
         int w, h;
         TTF_SizeText(gui::Texture::lastFont, "Select a Device:", &w, &h);
@@ -136,7 +262,22 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
         return EXIT_SUCCESS;
     }
 
+    opencl::Tuner::load();
     device.initialise();
+    data::FrameCache::queue = device.cQueue;
+    opencl::Arena::reclaim = data::FrameCache::shed;
+
+    if (bench && !useNative)
+    {
+        opencl::Benchmark::stencils(device);
+        opencl::Benchmark::pointwise(device);
+    }
+
+    if (useGroup && !useNative)
+    {
+        group.select();
+        group.initialise();
+    }
 
     mainWindow.drawables.clear();
 
@@ -173,35 +314,53 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
     auto reader = std::make_shared<ultrasound::Mindray>(device.context);
     inputTree->addLeaf(dropzone->buildKernel("MINDRAY", mainWindow.kernel, mainWindow.renderers, std::move(reader)), 4.0f);
 
-    auto polar      = std::make_shared<opencl::ToPolar>(device.context, device.cQueue, device.programs.at("cartesian")->at("toSpherical"));
-    auto cartesian  = std::make_shared<opencl::ToCartesian>(device.context, device.cQueue, device.programs.at("cartesian")->at("toCartesian"));
-    auto slice      = std::make_shared<opencl::Slice>(device.context, device.cQueue, device.programs.at("utility")->at("slice"));
-    auto threshold  = std::make_shared<opencl::Threshold>(device.context, device.cQueue, device.programs.at("utility")->at("threshold"));
-    auto invert     = std::make_shared<opencl::Invert>(device.context, device.cQueue, device.programs.at("utility")->at("invert"));
-    auto contrast   = std::make_shared<opencl::Contrast>(device.context, device.cQueue, device.programs.at("utility")->at("contrast"));
-    auto log        = std::make_shared<opencl::Log2>(device.context, device.cQueue, device.programs.at("utility")->at("logTwo"));
-    auto shrink     = std::make_shared<opencl::Shrink>(device.context, device.cQueue, device.programs.at("utility")->at("shrink"));
-    auto fade       = std::make_shared<opencl::Fade>(device.context, device.cQueue, device.programs.at("utility")->at("fade"));
-    auto sqrt       = std::make_shared<opencl::Sqrt>(device.context, device.cQueue, device.programs.at("utility")->at("square"));
-    auto clamp      = std::make_shared<opencl::Clamp>(device.context, device.cQueue, device.programs.at("utility")->at("clamping"));
-    auto colourise  = std::make_shared<opencl::Colourise>(device.context, device.cQueue, device.programs.at("utility")->at("colourise"));
-    auto median     = std::make_shared<opencl::Median>(device);
-    auto gaussian   = std::make_shared<opencl::Gaussian>(device);
-
-    dataTree->addLeaf(dropzone->buildKernel("To Polar", mainWindow.kernel, mainWindow.renderers, polar), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("To Cartesian", mainWindow.kernel, mainWindow.renderers, cartesian), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Slice", mainWindow.kernel, mainWindow.renderers, slice), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Threshold", mainWindow.kernel, mainWindow.renderers, threshold), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Invert", mainWindow.kernel, mainWindow.renderers, invert), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Clamp", mainWindow.kernel, mainWindow.renderers, clamp), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Contrast", mainWindow.kernel, mainWindow.renderers, contrast), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Log2", mainWindow.kernel, mainWindow.renderers, log), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Shrink", mainWindow.kernel, mainWindow.renderers, shrink), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Fade", mainWindow.kernel, mainWindow.renderers, fade), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Sqrt", mainWindow.kernel, mainWindow.renderers, sqrt), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Colourise", mainWindow.kernel, mainWindow.renderers, colourise), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Median", mainWindow.kernel, mainWindow.renderers, median), 4.0f);
-    dataTree->addLeaf(dropzone->buildKernel("Gaussian", mainWindow.kernel, mainWindow.renderers, gaussian), 4.0f);
+    if (useNative)
+    {
+        for (auto &[name, filter] : native::filters())
+        {
+            dataTree->addLeaf(dropzone->buildKernel(name, mainWindow.kernel, mainWindow.renderers, std::move(filter)), 4.0f);
+        }
+    }
+    else
+    {
+        auto polar      = std::make_shared<opencl::ToPolar>(device);
+        auto cartesian  = std::make_shared<opencl::ToCartesian>(device);
+        auto slice      = std::make_shared<opencl::Slice>(device.context, device.cQueue, device.programs.at("utility")->at("slice"));
+        auto threshold  = std::make_shared<opencl::Threshold>(device.context, device.cQueue, device.programs.at("utility")->at("threshold"));
+        auto invert     = std::make_shared<opencl::Invert>(device.context, device.cQueue, device.programs.at("utility")->at("invert"));
+        auto contrast   = std::make_shared<opencl::Contrast>(device.context, device.cQueue, device.programs.at("utility")->at("contrast"));
+        auto log        = std::make_shared<opencl::Log2>(device.context, device.cQueue, device.programs.at("utility")->at("logTwo"));
+        auto shrink     = std::make_shared<opencl::Shrink>(device.context, device.cQueue, device.programs.at("utility")->at("shrink"));
+        auto fade       = std::make_shared<opencl::Fade>(device.context, device.cQueue, device.programs.at("utility")->at("fade"));
+        auto sqrt       = std::make_shared<opencl::Sqrt>(device.context, device.cQueue, device.programs.at("utility")->at("square"));
+        auto clamp      = std::make_shared<opencl::Clamp>(device.context, device.cQueue, device.programs.at("utility")->at("clamping"));
+        auto colourise  = std::make_shared<opencl::Colourise>(device.context, device.cQueue, device.programs.at("utility")->at("colourise"));
+        auto median     = std::make_shared<opencl::Median>(device);
+        auto gaussian   = std::make_shared<opencl::Gaussian>(device);
+        auto morphology = std::make_shared<opencl::Morphology>(device);
+        auto boxMean    = std::make_shared<opencl::Box>(device, opencl::Box::Statistic::Mean);
+        auto boxVar     = std::make_shared<opencl::Box>(device, opencl::Box::Statistic::Variance);
+        auto adaptive   = std::make_shared<opencl::Box>(device, opencl::Box::Statistic::Threshold);
+
+        dataTree->addLeaf(dropzone->buildKernel("To Polar", mainWindow.kernel, mainWindow.renderers, polar), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("To Cartesian", mainWindow.kernel, mainWindow.renderers, cartesian), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Slice", mainWindow.kernel, mainWindow.renderers, slice), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Threshold", mainWindow.kernel, mainWindow.renderers, threshold), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Invert", mainWindow.kernel, mainWindow.renderers, invert), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Clamp", mainWindow.kernel, mainWindow.renderers, clamp), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Contrast", mainWindow.kernel, mainWindow.renderers, contrast), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Log2", mainWindow.kernel, mainWindow.renderers, log), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Shrink", mainWindow.kernel, mainWindow.renderers, shrink), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Fade", mainWindow.kernel, mainWindow.renderers, fade), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Sqrt", mainWindow.kernel, mainWindow.renderers, sqrt), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Colourise", mainWindow.kernel, mainWindow.renderers, colourise), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Median", mainWindow.kernel, mainWindow.renderers, median), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Gaussian", mainWindow.kernel, mainWindow.renderers, gaussian), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Morphology", mainWindow.kernel, mainWindow.renderers, morphology), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Box Mean", mainWindow.kernel, mainWindow.renderers, boxMean), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Box Variance", mainWindow.kernel, mainWindow.renderers, boxVar), 4.0f);
+        dataTree->addLeaf(dropzone->buildKernel("Adaptive Threshold", mainWindow.kernel, mainWindow.renderers, adaptive), 4.0f);
+    }
 
     auto binary = std::make_shared<io::Binary>(device.cQueue);
     auto nifti1 = std::make_shared<io::Nifti1>(device.cQueue);
@@ -209,6 +368,17 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
     outputTree->addLeaf(dropzone->buildKernel("Binary", mainWindow.kernel, mainWindow.renderers, binary), 4.0f);
     outputTree->addLeaf(dropzone->buildKernel("Nifti1", mainWindow.kernel, mainWindow.renderers, nifti1), 4.0f);
 
+    auto exportButton = gui::Button::build("Export All");
+    exportButton->onPress(
+        [&group, &device, pipelined, batch, slab]()
+        {
+            if (group.empty())
+                gui::Kernel::exportKernels(device, pipelined, batch, slab);
+            else
+                gui::Kernel::exportKernels(group);
+        });
+    outputTree->addLeaf(std::move(exportButton), 4.0f);
+
     mainWindow.addDrawable(std::shared_ptr(tree));
 
     // Hide Button
@@ -277,31 +447,41 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
         // Prepare GL buffers for interop.
         glFlush();
 
-        // If renderers are at the same frame, we can save disk loading costs.
-        auto sortedRenderers = mainWindow.renderers;
-        std::sort(sortedRenderers.begin(), sortedRenderers.end(), [](const std::shared_ptr<gui::Renderer> &sa, const std::shared_ptr<gui::Renderer> &sb)
-                  { return sa->cFrame < sb->cFrame; });
+        // Each renderer picks the frame it needs most, renderers on the same frame share one chain execution.
+        // Events are all drained above, so nothing is enqueued for parameters that have already moved on.
+        std::vector<std::shared_ptr<gui::Renderer>> due;
+        bool moving = false;
+        for (auto &renderer : mainWindow.renderers)
+        {
+            if (renderer->schedule())
+                due.push_back(renderer);
+            moving = moving || renderer->restarted;
+        }
+        std::sort(due.begin(), due.end(), [](const std::shared_ptr<gui::Renderer> &sa, const std::shared_ptr<gui::Renderer> &sb)
+                  { return sa->rFrame < sb->rFrame; });
 
         int lastR = -1;
-        for (auto &&renderer : sortedRenderers)
+        for (auto &&renderer : due)
         {
-            if (renderer->modified)
+            if (lastR == -1 || static_cast<cl_uint>(lastR) != renderer->rFrame)
             {
-                if (lastR == -1 || static_cast<cl_uint>(lastR) != renderer->rFrame)
-                {
-                    gui::Kernel::executeKernels(renderer->rFrame); // Run kernels at specified frame
-                    lastR = renderer->rFrame;
-                }
+                // While a slider is being dragged one chain execution per tick bounds the latency, the other
+                // frames wait until the values settle.
+                if (moving && lastR != -1)
+                    break;
 
-                renderer->updateView(); // Update rotation, translation, scale
+                gui::Kernel::executeKernels(renderer->rFrame); // Run kernels at specified frame
+                lastR = renderer->rFrame;
+            }
 
-                auto start = std::chrono::steady_clock::now();
-                device.render(*renderer); // 3D -> 2D render
-                auto stop = std::chrono::steady_clock::now();
-                std::cout << "Kernel Execution Time: " << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(stop - start).count() << "ms" << std::endl;
+            renderer->updateView(); // Update rotation, translation, scale
 
-                renderer->addFrame(device.pixelBuffer); // Save 2D frame into rendered footage
-            }
+            auto start = std::chrono::steady_clock::now();
+            device.render(*renderer); // 3D -> 2D render
+            auto stop = std::chrono::steady_clock::now();
+            std::cout << "Kernel Execution Time: " << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(stop - start).count() << "ms" << std::endl;
+
+            renderer->addFrame(device.pixelBuffer); // Save 2D frame into rendered footage
         }
 
         // Run OpenGL stuff
@@ -319,5 +499,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
         timeA = SDL_GetTicks();
     }
 
+    opencl::Tuner::report();
+
     return EXIT_SUCCESS;
 }